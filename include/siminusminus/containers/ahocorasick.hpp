@@ -0,0 +1,189 @@
+#ifndef SIMINUSMINUS_CONTAINERS_AHOCORASICK_HPP
+#define SIMINUSMINUS_CONTAINERS_AHOCORASICK_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/containers/inmutablestring.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \ingroup containers
+ * \brief A match reported by an AhoCorasickMatcher.
+ */
+struct AhoCorasickMatch
+{
+    std::size_t pattern; // Index of the matched pattern in the collection given to the matcher
+    std::size_t offset;  // Offset of the first character of the match in the scanned text
+};
+
+/**
+ * \ingroup containers
+ * \brief Multi-pattern string matcher.
+ *
+ * The AhoCorasickMatcher compiles a collection of patterns into a deterministic
+ * automaton, so a text is scanned once no matter how many patterns we are looking for.
+ * For example:
+ *
+ * ``` cpp
+ * cmm::containers::AhoCorasickMatcher matcher({"he", "she", "hers"});
+ * cmm::containers::InmutableString text("ushers");
+ *
+ * matcher.scan(text.view(), [](const cmm::containers::AhoCorasickMatch& match)
+ * {
+ *     std::cout << match.pattern << " at " << match.offset << std::endl; // 1 at 1, 0 at 2, 2 at 2
+ * });
+ * ```
+ *
+ * Bytes that do not appear in any pattern share a single input class, so each state
+ * only stores one transition per distinct pattern byte. Transitions are stored in a flat
+ * row-major table.
+ *
+ * When every pattern contains one of at most three bytes, the scan looks for those bytes
+ * with SIMD comparisons and only runs the automaton near them. The bytes are the ones
+ * starting the patterns if there are few, or else the rarest byte of each pattern in
+ * typical text, so `"user_id="`, `"session_id="` and `"request_id="` are prefiltered on
+ * `_`. Sets with more than three distinct rare bytes, such as thousands
+ * of unrelated keywords, are scanned without prefilter, at one table lookup per byte
+ * whatever the number of patterns. The prefilter only pays off when its bytes are rare
+ * in the scanned text.
+ *
+ * Empty patterns never match.
+ */
+class AhoCorasickMatcher
+{
+public:
+
+    /**
+     * Builds the automaton from a collection of patterns. The id of each pattern is
+     * its index in the collection. Throws std::length_error if the transition table
+     * would have 2^31 entries or more.
+     * @param patterns: patterns to look for.
+     */
+    AhoCorasickMatcher(const std::vector<InmutableString>& patterns);
+
+    /**
+     * Scans the text calling callback(const AhoCorasickMatch&) for every occurrence of
+     * every pattern, ordered by the end of the match. Overlapping matches are reported.
+     * @param text: text to scan.
+     * @param callback: function called for each match.
+     */
+    template <typename Callback>
+    void scan(const ConstContiguousView<char>& text, Callback&& callback) const
+    {
+        const unsigned char* const begin = reinterpret_cast<const unsigned char*>(text.data());
+        const unsigned char* const end = begin + text.size();
+        const unsigned char* it = begin;
+        const unsigned char* candidate = nullptr; // Next prefilter byte, once found
+        std::uint32_t state = 0;                  // Root
+
+        while (it != end)
+        {
+            if (state == 0 && _prefilterSize != 0)
+            {
+                it = skipToCandidate(it, end, candidate);
+
+                if (it == end)
+                    break;
+            }
+
+            state = _transitions[state + _classes[*it]];
+            ++it;
+
+            if (state & MatchFlag)
+            {
+                state &= ~MatchFlag;
+                reportMatches(state / _classCount, static_cast<std::size_t>(it - begin), callback);
+            }
+        }
+    }
+
+    /**
+     * Appends all the matches found in the text to the given buffer.
+     * Returns the number of matches found.
+     * @param text: text to scan.
+     * @param matches: output buffer.
+     */
+    std::size_t findAll(const ConstContiguousView<char>& text, std::vector<AhoCorasickMatch>& matches) const;
+
+    /**
+     * Returns true if any of the patterns occurs in the text.
+     * @param text: text to scan.
+     */
+    bool containsAny(const ConstContiguousView<char>& text) const;
+
+    /**
+     * Returns the number of patterns the matcher was built from.
+     */
+    std::size_t patternCount() const;
+
+    /**
+     * Returns the number of states of the automaton.
+     */
+    std::size_t stateCount() const;
+
+private:
+
+    static const std::uint32_t MatchFlag = 0x80000000u; // Set on transitions to states with matches
+    static const std::uint32_t NoLink = 0xFFFFFFFFu;    // Output link of states without outputs below
+
+    /**
+     * Calls callback for the patterns ending at state and at its output links.
+     * @param state: state reached (not premultiplied).
+     * @param end: offset of the end of the matches.
+     * @param callback: function called for each match.
+     */
+    template <typename Callback>
+    void reportMatches(std::uint32_t state, std::size_t end, Callback& callback) const
+    {
+        while (state != NoLink)
+        {
+            for (std::uint32_t i = _outputBegin[state]; i != _outputBegin[state + 1]; ++i)
+            {
+                const std::uint32_t pattern = _outputs[i];
+                callback(AhoCorasickMatch{pattern, end - _patternLengths[pattern]});
+            }
+
+            state = _outputLinks[state];
+        }
+    }
+
+    /**
+     * Returns the first position in [from, end) where a match can start, or end if
+     * there is none.
+     * @param from: start of the search.
+     * @param end: end of the search.
+     * @param candidate: next prefilter byte found by a previous call, or nullptr. Updated.
+     */
+    const unsigned char* skipToCandidate(const unsigned char* from, const unsigned char* end,
+                                         const unsigned char*& candidate) const;
+
+    /**
+     * Returns the first position in [from, end) holding a prefilter byte, or end if
+     * there is none.
+     * @param from: start of the search.
+     * @param end: end of the search.
+     */
+    const unsigned char* findPrefilterByte(const unsigned char* from, const unsigned char* end) const;
+
+    std::array<std::uint16_t, 256> _classes;      // Input class of each byte
+    std::uint32_t _classCount;                    // Number of input classes
+    std::vector<std::uint32_t> _transitions;      // Premultiplied next state, per state and input class
+    std::vector<std::uint32_t> _outputBegin;      // Range of _outputs ending at each state
+    std::vector<std::uint32_t> _outputs;          // Ids of the patterns ending at each state
+    std::vector<std::uint32_t> _outputLinks;      // Nearest proper suffix state with outputs
+    std::vector<std::size_t> _patternLengths;     // Length of each pattern
+    std::array<unsigned char, 3> _prefilter;      // Bytes every pattern contains one of
+    std::array<std::size_t, 3> _prefilterOffsets; // Most bytes before the first _prefilter byte of a pattern
+    std::size_t _prefilterSize;                   // Number of bytes in _prefilter, 0 if disabled
+
+}; // class AhoCorasickMatcher
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_AHOCORASICK_HPP
@@ -0,0 +1,531 @@
+#ifndef SIMINUSMINUS_CONTAINERS_BASICINMUTABLESTRING_HPP
+#define SIMINUSMINUS_CONTAINERS_BASICINMUTABLESTRING_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/containers/inmutablestringlogging.hpp>
+#include <siminusminus/containers/inmutablestringstorage.hpp>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace cmm {
+namespace containers {
+
+namespace detail {
+
+/**
+ * Returns true for the ASCII whitespace characters (' ', '\t', '\n', '\v', '\f' and '\r').
+ */
+template <typename CharT>
+bool isSpace(const CharT c)
+{
+    return c == CharT(' ') || (c >= CharT('\t') && c <= CharT('\r'));
+}
+
+/**
+ * Copies length characters from in to out, adding delta to the ones in [first, first + 25].
+ * Used for the ASCII case conversions.
+ */
+template <typename CharT>
+void shiftRange(const CharT* in, CharT* out, std::size_t length, const CharT first, const CharT delta)
+{
+    for (std::size_t i = 0; i < length; ++i)
+        out[i] = (in[i] >= first && in[i] <= first + 25) ? static_cast<CharT>(in[i] + delta) : in[i];
+}
+
+/**
+ * SIMD version of shiftRange() for char strings.
+ */
+void shiftRange(const char* in, char* out, std::size_t length, const char first, const char delta);
+
+/**
+ * Copies length characters from in to out, replacing from by to.
+ */
+template <typename CharT>
+void replaceChar(const CharT* in, CharT* out, std::size_t length, const CharT from, const CharT to)
+{
+    for (std::size_t i = 0; i < length; ++i)
+        out[i] = in[i] == from ? to : in[i];
+}
+
+/**
+ * SIMD version of replaceChar() for char strings.
+ */
+void replaceChar(const char* in, char* out, std::size_t length, const char from, const char to);
+
+/**
+ * Returns the first occurrence of needle in [from, to), or nullptr. needle must not be empty.
+ */
+template <typename CharT>
+const CharT* search(const CharT* from, const CharT* to, const ConstContiguousView<CharT>& needle)
+{
+    typedef std::char_traits<CharT> Traits;
+    const std::size_t length = needle.size();
+
+    while (static_cast<std::size_t>(to - from) >= length)
+    {
+        const CharT* candidate = Traits::find(from, static_cast<std::size_t>(to - from) - length + 1, needle.data()[0]);
+
+        if (candidate == nullptr)
+            return nullptr;
+
+        if (Traits::compare(candidate + 1, needle.data() + 1, length - 1) == 0)
+            return candidate;
+
+        from = candidate + 1;
+    }
+
+    return nullptr;
+}
+
+} // namespace detail
+
+/**
+ * \ingroup containers
+ * \brief Implements an inmutable string
+ *
+ * Inmutable strings are string objects that cannot be
+ * modified after being initialized with a given value.
+ * For example:
+ *
+ * ``` cpp
+ * cmm::containers::InmutableString str{"hello, world!"};
+ *
+ * std::cout << str[0]; // Ok
+ * str[0] = 'a'; // Not Ok
+ *
+ * auto str2 = str + "foo"; // Ok
+ * str += "foo"; // Not Ok
+ * ```
+ *
+ * Where the characters live is decided by the StoragePolicy (see \ref inmutablestringstorage)
+ * and what the string logs by the LoggingPolicy (see \ref inmutablestringlogging).
+ * InmutableString is the string of char with HeapStorage and DebugLogging. Every member
+ * is defined in this header, so the accessors are inlined in the calling code.
+ */
+template <template <typename> class StoragePolicy, typename LoggingPolicy, typename CharT>
+class BasicInmutableString
+{
+    static_assert(std::is_trivial<CharT>::value, "BasicInmutableString requires a trivial character type");
+
+public:
+
+    /**
+     * Default constructor.
+     * by default a string with the "" chain is created.
+     */
+    BasicInmutableString()
+    {
+        LoggingPolicy::log("+++ InmutableString() called. void string created.");
+        stringLog();
+    }
+
+    /**
+     * Contructor from a C string.
+     * @param string: chain to create a InmutableString object.
+     */
+    BasicInmutableString(const CharT* string)
+    {
+        const typename LoggingPolicy::Scope scope("InmutableString(const CharT*)");
+        const std::size_t length = std::char_traits<CharT>::length(string);
+        std::memcpy(_storage.allocate(length), string, length * sizeof(CharT));
+
+        LoggingPolicy::log("+++ InmutableString(const char* string) called.");
+        stringLog();
+    }
+
+    /**
+     * Contructor from a range of characters.
+     * @param view: characters to create a InmutableString object.
+     */
+    explicit BasicInmutableString(const ConstContiguousView<CharT>& view)
+    {
+        const typename LoggingPolicy::Scope scope("InmutableString(const ConstContiguousView<CharT>&)");
+        CharT* characters = _storage.allocate(view.size());
+
+        if (!view.empty())
+            std::memcpy(characters, view.data(), view.size() * sizeof(CharT));
+
+        LoggingPolicy::log("+++ InmutableString(const ConstContiguousView<char>& view) called.");
+        stringLog();
+    }
+
+    /**
+     * Copy constructor. creates a new InmutableString object from another (istring).
+     * @param istring: The object which copy the data to create another InmutableSring object.
+     */
+    BasicInmutableString(const BasicInmutableString& istring): _storage(istring._storage)
+    {
+        LoggingPolicy::log("+++ InmutableString(const InmutableString& istring). Copy constructor.");
+    }
+
+    /**
+     * Move constructor. creates a new inmutable object from an rvalue InmutableString.
+     * The rvalue is left empty.
+     * @param istring: The object that we steal the value.
+     */
+    BasicInmutableString(BasicInmutableString&& istring) noexcept: _storage(std::move(istring._storage))
+    {
+        LoggingPolicy::log("+++ InmutableString(const InmutableString&& istring). Move constructor.");
+    }
+
+    /**
+     * Default destructor. Free an InmutableString.
+     */
+    ~BasicInmutableString()
+    {
+        LoggingPolicy::log("--- ~InmutableString().");
+        stringLog();
+    }
+
+    /**
+     * Returns the i th position from our string.
+     * @param index: index to string access.
+     */
+    const CharT& operator[](const std::size_t index) const
+    {
+        return _storage.data()[index];
+    }
+
+    /**
+     * An InmutableString is equal to another if their strings values
+     * are the same.
+     *
+     * To compare and do other operations like ( >, <, >= and <=) we use the
+     * lexicographical order. == and != are an exception, comparing the lengths
+     * first for efficiency.
+     * @param rhs: the right hand side of the operation.
+     */
+    bool operator==(const BasicInmutableString& rhs) const
+    {
+        return length() == rhs.length() &&
+               std::char_traits<CharT>::compare(data(), rhs.data(), length()) == 0;
+    }
+
+    /**
+     * An InmutableString isn't equal to another if their strings values
+     * aren't the same.
+     * @param rhs: the right hand side of the operation.
+     */
+    bool operator!=(const BasicInmutableString& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * Returns the true if lhs is greater lexicographically than rhs.
+     * @param rhs: the right hand side of the operation.
+     */
+    bool operator>(const BasicInmutableString& rhs) const
+    {
+        return compare(rhs) > 0;
+    }
+
+    /**
+     * Returns the true if rhs is greater lexicographically than lhs.
+     * @param rhs: the right hand side of the operation.
+     */
+    bool operator<(const BasicInmutableString& rhs) const
+    {
+        return compare(rhs) < 0;
+    }
+
+    /**
+     * Returns the true if lhs is greater or equal lexicographically than rhs.
+     * @param rhs: the right hand side of the operation.
+     */
+    bool operator>=(const BasicInmutableString& rhs) const
+    {
+        return compare(rhs) >= 0;
+    }
+
+    /**
+     * Returns the true if rhs is greater or equal lexicographically than lhs.
+     * @param rhs: the right hand side of the operation.
+     */
+    bool operator<=(const BasicInmutableString& rhs) const
+    {
+        return compare(rhs) <= 0;
+    }
+
+    /**
+     * Assignment operator. Copy the InmutableString of right hand side to
+     * the left hand side.
+     * @param rhs: the right hand side of the operation.
+     */
+    BasicInmutableString& operator=(const BasicInmutableString& rhs)
+    {
+        LoggingPolicy::log("*** InmutableString::operator=(const InmutableString& rhs).");
+
+        if (this != &rhs) // Not doing the assignment if it points to the same data
+            _storage = rhs._storage;
+
+        return *this;
+    }
+
+    /**
+     * Move assignment operator. Steal the InmutableString of right hand side value to
+     * the left hand side. The right hand side is left empty.
+     * @param rhs: the right hand side of the operation.
+     */
+    BasicInmutableString& operator=(BasicInmutableString&& rhs) noexcept
+    {
+        LoggingPolicy::log("*** InmutableString::operator=(const InmutableString&& rhs).");
+
+        if (this != &rhs)
+            _storage = std::move(rhs._storage);
+
+        return *this;
+    }
+
+    /**
+     * Returns the concatenation of lhs and rhs, allocated once.
+     * @param lhs: the left hand side of the operation.
+     * @param rhs: the right hand side of the operation.
+     */
+    friend BasicInmutableString operator+(const BasicInmutableString& lhs, const BasicInmutableString& rhs)
+    {
+        const typename LoggingPolicy::Scope scope("InmutableString operator+");
+        LoggingPolicy::log("*** operator+(InmutableString lhs, const InmutableString& rhs).");
+
+        CharT* characters;
+        BasicInmutableString result(Uninitialized(), lhs.length() + rhs.length(), characters);
+
+        std::memcpy(characters, lhs.data(), lhs.length() * sizeof(CharT));
+        std::memcpy(characters + lhs.length(), rhs.data(), rhs.length() * sizeof(CharT));
+        result.stringLog();
+
+        return result;
+    }
+
+    /**
+     * Given a InmutableString object and a output buffer, it writes the string to
+     * the given buffer.
+     * @param os: output buffer.
+     * @param istring: Inmutable string object.
+     */
+    friend std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const BasicInmutableString& istring)
+    {
+        return os.write(istring.data(), static_cast<std::streamsize>(istring.length()));
+    }
+
+    /**
+     * Returns an std::string c++ object.
+     */
+    std::basic_string<CharT> toString() const
+    {
+        return std::basic_string<CharT>(data(), length());
+    }
+
+    /**
+     * Returns the InmutableString length. The length NOT includes the end character '\0'.
+     */
+    std::size_t length() const
+    {
+        return _storage.length();
+    }
+
+    /**
+     * Returns a pointer to the characters of the string, followed by the end character '\0'.
+     */
+    const CharT* data() const
+    {
+        return _storage.data();
+    }
+
+    /**
+     * Returns a view of the characters of the string. The view NOT includes the end character '\0'.
+     */
+    ConstContiguousView<CharT> view() const
+    {
+        return ConstContiguousView<CharT>(data(), data() + length());
+    }
+
+    /**
+     * Returns the storage of the string.
+     */
+    const StoragePolicy<CharT>& storage() const
+    {
+        return _storage;
+    }
+
+    /**
+     * Returns a copy of the string with the ASCII uppercase letters converted to lowercase.
+     */
+    BasicInmutableString toLower() const
+    {
+        CharT* characters;
+        BasicInmutableString result(Uninitialized(), length(), characters);
+        detail::shiftRange(data(), characters, length(), CharT('A'), CharT('a' - 'A'));
+
+        return result;
+    }
+
+    /**
+     * Returns a copy of the string with the ASCII lowercase letters converted to uppercase.
+     */
+    BasicInmutableString toUpper() const
+    {
+        CharT* characters;
+        BasicInmutableString result(Uninitialized(), length(), characters);
+        detail::shiftRange(data(), characters, length(), CharT('a'), static_cast<CharT>('A' - 'a'));
+
+        return result;
+    }
+
+    /**
+     * Returns a copy of the string without the leading and trailing ASCII whitespace.
+     */
+    BasicInmutableString trim() const
+    {
+        const CharT* begin = data();
+        const CharT* end = data() + length();
+
+        while (begin != end && detail::isSpace(*begin))
+            ++begin;
+
+        while (end != begin && detail::isSpace(*(end - 1)))
+            --end;
+
+        return BasicInmutableString(ConstContiguousView<CharT>(begin, end));
+    }
+
+    /**
+     * Returns a copy of the string with the runs of ASCII whitespace replaced by a single space.
+     */
+    BasicInmutableString collapseWhitespace() const
+    {
+        const CharT* const string = data();
+
+        // First pass computes the exact length of the result
+        std::size_t newLength = 0;
+
+        for (std::size_t i = 0; i < length(); ++i)
+            newLength += !detail::isSpace(string[i]) || i == 0 || !detail::isSpace(string[i - 1]);
+
+        CharT* out;
+        BasicInmutableString result(Uninitialized(), newLength, out);
+
+        for (std::size_t i = 0; i < length(); ++i)
+        {
+            if (!detail::isSpace(string[i]))
+                *out++ = string[i];
+            else if (i == 0 || !detail::isSpace(string[i - 1]))
+                *out++ = CharT(' ');
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns a copy of the string with every occurrence of a character replaced by another.
+     * @param from: character to replace.
+     * @param to: replacement character.
+     */
+    BasicInmutableString replace(CharT from, CharT to) const
+    {
+        CharT* characters;
+        BasicInmutableString result(Uninitialized(), length(), characters);
+        detail::replaceChar(data(), characters, length(), from, to);
+
+        return result;
+    }
+
+    /**
+     * Returns a copy of the string with every occurrence of from replaced by to. Occurrences are
+     * searched from left to right and do not overlap. If from is empty, the copy is unchanged.
+     * @param from: sequence to replace.
+     * @param to: replacement sequence.
+     */
+    BasicInmutableString replaceAll(const ConstContiguousView<CharT>& from, const ConstContiguousView<CharT>& to) const
+    {
+        const CharT* const end = data() + length();
+
+        if (from.empty())
+            return *this;
+
+        // First pass counts the occurrences to compute the exact length of the result
+        std::size_t occurrences = 0;
+
+        for (const CharT* it = detail::search(data(), end, from); it != nullptr; it = detail::search(it + from.size(), end, from))
+            ++occurrences;
+
+        if (occurrences == 0)
+            return *this;
+
+        CharT* out;
+        BasicInmutableString result(Uninitialized(), length() - occurrences * from.size() + occurrences * to.size(), out);
+        const CharT* last = data();
+
+        for (const CharT* it = detail::search(last, end, from); it != nullptr; it = detail::search(last, end, from))
+        {
+            std::memcpy(out, last, static_cast<std::size_t>(it - last) * sizeof(CharT));
+            out += it - last;
+
+            if (!to.empty())
+                std::memcpy(out, to.data(), to.size() * sizeof(CharT));
+
+            out += to.size();
+            last = it + from.size();
+        }
+
+        std::memcpy(out, last, static_cast<std::size_t>(end - last) * sizeof(CharT));
+
+        return result;
+    }
+
+private:
+
+    /**
+     * Tag to select the constructor that leaves the characters uninitialized.
+     */
+    struct Uninitialized {};
+
+    /**
+     * Constructor that allocates a string of the given length, leaving its characters
+     * uninitialized (only the end character '\0' is written). Used by the transforms to
+     * fill the result in place.
+     * @param length: length of the string.
+     * @param characters: set to the characters to fill.
+     */
+    BasicInmutableString(Uninitialized, const std::size_t length, CharT*& characters)
+    {
+        characters = _storage.allocate(length);
+        LoggingPolicy::log("+++ InmutableString(const size_t length, Uninitialized) called.");
+    }
+
+    /**
+     * Three-way lexicographical comparison.
+     * @param rhs: the right hand side of the comparison.
+     */
+    int compare(const BasicInmutableString& rhs) const
+    {
+        const std::size_t common = length() < rhs.length() ? length() : rhs.length();
+        const int result = std::char_traits<CharT>::compare(data(), rhs.data(), common);
+
+        if (result != 0)
+            return result;
+
+        return length() < rhs.length() ? -1 : (length() > rhs.length() ? 1 : 0);
+    }
+
+    /**
+     * For debug. The function returns the length and the string from the
+     * InmutableString object.
+     */
+    void stringLog() const
+    {
+        LoggingPolicy::logString(data(), length());
+    }
+
+    StoragePolicy<CharT> _storage; // Characters of the string
+
+}; // class BasicInmutableString
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_BASICINMUTABLESTRING_HPP
@@ -2,6 +2,9 @@
 #define SIMINUSMINUS_CONTAINERS_CONSTCONTIGUOUSITERATOR_HPP
 
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
 
 namespace cmm {
 namespace containers {
@@ -128,6 +131,23 @@ public:
         return *_pointer;
     }
 
+    /**
+     * Gets a pointer to the object pointed.
+     */
+    const T* operator->() const
+    {
+        return _pointer;
+    }
+
+    /**
+     * Returns the number of elements between rhs and this iterator.
+     * @param rhs: right hand side object.
+     */
+    std::ptrdiff_t operator-(const ConstContiguousIterator<T>& rhs) const
+    {
+        return _pointer - rhs._pointer;
+    }
+
     /**
      * Given a ConstContiguousIterator object and a output buffer, it writes the string to 
      * the given buffer.
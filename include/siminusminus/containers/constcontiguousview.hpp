@@ -2,6 +2,7 @@
 #define SIMINUSMINUS_CONTAINERS_CONSTCONTIGUOUSVIEW_HPP
 
 #include <siminusminus/containers/constcontiguousiterator.hpp>
+#include <cstddef>
 
 namespace cmm {
 namespace containers {
@@ -49,6 +50,30 @@ public:
         return _end;
     }
 
+    /**
+     * Returns a pointer to the first element of the range.
+     */
+    const T* data() const
+    {
+        return _begin.operator->();
+    }
+
+    /**
+     * Returns the number of elements of the range.
+     */
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(_end - _begin);
+    }
+
+    /**
+     * Returns true if the range has no elements.
+     */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
 private:
 
     const ConstContiguousIterator<T> _begin; // Beginning of the view
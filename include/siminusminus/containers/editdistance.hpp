@@ -0,0 +1,132 @@
+#ifndef SIMINUSMINUS_CONTAINERS_EDITDISTANCE_HPP
+#define SIMINUSMINUS_CONTAINERS_EDITDISTANCE_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/containers/inmutablestring.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \ingroup containers
+ * \brief A candidate within the distance threshold of a FuzzyMatcher query.
+ */
+struct FuzzyMatch
+{
+    std::size_t candidate; // Index of the candidate in the collection given to the matcher
+    std::size_t distance;  // Edit distance between the query and the candidate
+};
+
+/**
+ * \ingroup containers
+ * \brief Levenshtein distance from one query to many candidates.
+ *
+ * The FuzzyMatcher implements the bit-parallel algorithm of Myers, as formulated by
+ * Hyyrö: each text character updates a whole column of the dynamic programming matrix
+ * with a few word operations, 64 query characters per word. The per-character match
+ * masks of the query are computed once, in the constructor, and shared by all the
+ * comparisons. For example:
+ *
+ * ``` cpp
+ * cmm::containers::InmutableString query("example.com");
+ * cmm::containers::FuzzyMatcher matcher(query.view());
+ * std::vector<cmm::containers::FuzzyMatch> matches;
+ *
+ * matcher.findWithin(hostnames, 2, matches); // Hostnames at most 2 edits away
+ * ```
+ *
+ * Characters are compared byte by byte.
+ */
+class FuzzyMatcher
+{
+public:
+
+    /**
+     * Value used as threshold to compute exact distances.
+     */
+    static const std::size_t Unbounded = static_cast<std::size_t>(-1);
+
+    /**
+     * Prepares the matcher for a query.
+     * @param query: string the candidates are compared with.
+     */
+    explicit FuzzyMatcher(const ConstContiguousView<char>& query);
+
+    /**
+     * Returns the edit distance between the query and a candidate.
+     * @param candidate: string to compare with the query.
+     */
+    std::size_t distance(const ConstContiguousView<char>& candidate) const;
+
+    /**
+     * Returns the edit distance between the query and a candidate if it is at most k,
+     * or k + 1 otherwise. The comparison stops as soon as the distance is known to be
+     * greater than k.
+     * @param candidate: string to compare with the query.
+     * @param k: distance threshold.
+     */
+    std::size_t distance(const ConstContiguousView<char>& candidate, std::size_t k) const;
+
+    /**
+     * Appends to matches the candidates at most k edits away from the query, in order.
+     * Returns the number of matches found. On SSE2 targets, queries of up to 64
+     * characters are compared with two candidates at a time.
+     * @param candidates: strings to compare with the query.
+     * @param k: distance threshold.
+     * @param matches: output buffer.
+     */
+    std::size_t findWithin(const std::vector<InmutableString>& candidates, std::size_t k, std::vector<FuzzyMatch>& matches) const;
+
+    /**
+     * Returns the length of the query.
+     */
+    std::size_t queryLength() const;
+
+private:
+
+    /**
+     * Distance for queries of up to 64 characters.
+     */
+    std::size_t distanceSingleWord(const unsigned char* text, std::size_t length, std::size_t k) const;
+
+    /**
+     * Distance for longer queries, one word per 64 characters.
+     */
+    std::size_t distanceMultiWord(const unsigned char* text, std::size_t length, std::size_t k) const;
+
+    /**
+     * distanceSingleWord() for two candidates at once. Results are stored in distances.
+     */
+    void distancePair(const ConstContiguousView<char>& first, const ConstContiguousView<char>& second,
+                      std::size_t k, std::size_t distances[2]) const;
+
+    std::size_t _length;                // Length of the query
+    std::size_t _words;                 // Words per column
+    std::vector<std::uint64_t> _masks;  // Bit i of word w of byte c is set if query[64 * w + i] == c
+
+}; // class FuzzyMatcher
+
+/**
+ * \ingroup containers
+ * Returns the edit (Levenshtein) distance between two strings.
+ * @param lhs: the left hand side of the comparison.
+ * @param rhs: the right hand side of the comparison.
+ */
+std::size_t editDistance(const ConstContiguousView<char>& lhs, const ConstContiguousView<char>& rhs);
+
+/**
+ * \ingroup containers
+ * Returns the edit distance between two strings if it is at most k, or k + 1 otherwise.
+ * @param lhs: the left hand side of the comparison.
+ * @param rhs: the right hand side of the comparison.
+ * @param k: distance threshold.
+ */
+std::size_t boundedEditDistance(const ConstContiguousView<char>& lhs, const ConstContiguousView<char>& rhs, std::size_t k);
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_EDITDISTANCE_HPP
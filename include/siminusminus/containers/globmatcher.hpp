@@ -0,0 +1,212 @@
+#ifndef SIMINUSMINUS_CONTAINERS_GLOBMATCHER_HPP
+#define SIMINUSMINUS_CONTAINERS_GLOBMATCHER_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/containers/inmutablestring.hpp>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cmm {
+namespace containers {
+
+namespace detail {
+
+/**
+ * Point of a compiled glob pattern, before one of its items or at its end.
+ */
+struct GlobPosition
+{
+    std::bitset<256> bytes; // Bytes accepted by the item, if it is not a star
+    bool star;              // True before a `*`
+    bool end;               // True at the end of the pattern
+    std::uint32_t pattern;  // Id of the pattern
+};
+
+/**
+ * Trie of literal glob patterns, flattened into arrays.
+ */
+struct GlobLiteralTrie
+{
+    std::vector<std::uint32_t> edgeBegin;   // Range of edges leaving each node
+    std::vector<unsigned char> labels;      // Byte of each edge, sorted for each node
+    std::vector<std::uint32_t> children;    // Node reached by each edge
+    std::vector<std::uint32_t> outputBegin; // For node n, range 2n of open patterns and 2n + 1 of exact ones
+    std::vector<std::uint32_t> outputs;     // Ids of the patterns ending at each node
+
+    /**
+     * Walks the text (backwards if reversed) calling callback(std::size_t pattern) for
+     * the open patterns that are a prefix of the walked text and the exact patterns
+     * equal to it.
+     */
+    template <typename Callback>
+    void walk(const ConstContiguousView<char>& text, bool reversed, Callback& callback) const
+    {
+        if (edgeBegin.empty())
+            return;
+
+        const unsigned char* const bytes = reinterpret_cast<const unsigned char*>(text.data());
+        const std::size_t length = text.size();
+        std::uint32_t node = 0;
+
+        for (std::size_t i = 0;; ++i)
+        {
+            for (std::uint32_t output = outputBegin[2 * node]; output != outputBegin[2 * node + 1]; ++output)
+                callback(static_cast<std::size_t>(outputs[output]));
+
+            if (i == length)
+                break;
+
+            const unsigned char c = bytes[reversed ? length - 1 - i : i];
+            const unsigned char* const first = labels.data() + edgeBegin[node];
+            const unsigned char* const last = labels.data() + edgeBegin[node + 1];
+            const unsigned char* const edge = std::lower_bound(first, last, c);
+
+            if (edge == last || *edge != c)
+                return;
+
+            node = children[static_cast<std::size_t>(edge - labels.data())];
+        }
+
+        for (std::uint32_t output = outputBegin[2 * node + 1]; output != outputBegin[2 * node + 2]; ++output)
+            callback(static_cast<std::size_t>(outputs[output]));
+    }
+};
+
+} // namespace detail
+
+/**
+ * \ingroup containers
+ * \brief Matches strings against a set of glob patterns.
+ *
+ * The supported syntax is:
+ *
+ *  - `*` matches any sequence of characters, including the empty one.
+ *  - `?` matches any character.
+ *  - `[abc]`, `[a-z]` match one of the listed characters. `[!abc]` and `[^abc]` match
+ *    any other character. A `]` right after the opening `[` (or `[!`) is a literal.
+ *  - `\` makes the next character a literal.
+ *
+ * Patterns must match the whole string. For example:
+ *
+ * ``` cpp
+ * cmm::containers::GlobMatcher rules({"logs.*", "*.json", "img[0-9]?.png"});
+ * cmm::containers::InmutableString key("img42.png");
+ *
+ * rules.match(key.view(), [](std::size_t pattern)
+ * {
+ *     std::cout << "rule " << pattern << " matched" << std::endl; // rule 2 matched
+ * });
+ * ```
+ *
+ * Patterns that are plain literals, literal prefixes (`literal*`) or literal suffixes
+ * (`*literal`) are stored in two tries, walked forwards and backwards over the text, so
+ * their cost depends on the length of the text and not on their number. The rest are
+ * compiled together into one deterministic automaton over classes of equivalent bytes,
+ * which matches in linear time without allocating.
+ *
+ * Some sets of patterns need exponentially many automaton states, like `*a???????`.
+ * At most MaxStates states are built: a text reaching a state that was not built is
+ * matched from there by following the positions of the patterns, which allocates and
+ * costs time proportional to the number of positions for each character.
+ */
+class GlobMatcher
+{
+public:
+
+    /**
+     * Most automaton states built by the constructor.
+     */
+    static const std::size_t MaxStates = 4096;
+
+    /**
+     * Compiles a set of patterns. The id of each pattern is its index in the collection.
+     * @param patterns: glob patterns.
+     */
+    GlobMatcher(const std::vector<InmutableString>& patterns);
+
+    /**
+     * Calls callback(std::size_t pattern) for each pattern matching the text, in no
+     * particular order.
+     * @param text: text to match.
+     * @param callback: function called for each matching pattern.
+     */
+    template <typename Callback>
+    void match(const ConstContiguousView<char>& text, Callback&& callback) const
+    {
+        _prefixes.walk(text, false, callback);
+        _suffixes.walk(text, true, callback);
+
+        std::vector<std::uint32_t> simulated;
+        std::size_t count;
+        const std::uint32_t* accepted = runAutomaton(text, simulated, count);
+
+        for (std::size_t i = 0; i < count; ++i)
+            callback(static_cast<std::size_t>(accepted[i]));
+    }
+
+    /**
+     * Returns true if any of the patterns matches the text.
+     * @param text: text to match.
+     */
+    bool matchesAny(const ConstContiguousView<char>& text) const;
+
+    /**
+     * Appends the ids of the patterns matching the text to matches, in increasing order.
+     * Returns the number of patterns that matched.
+     * @param text: text to match.
+     * @param matches: output buffer.
+     */
+    std::size_t matchAll(const ConstContiguousView<char>& text, std::vector<std::size_t>& matches) const;
+
+    /**
+     * Returns the number of patterns the matcher was built from.
+     */
+    std::size_t patternCount() const;
+
+    /**
+     * Returns the number of states built for the automaton (0 if all the patterns are
+     * literals).
+     */
+    std::size_t stateCount() const;
+
+private:
+
+    /**
+     * Runs the automaton over the text and returns the ids of the accepted patterns.
+     * @param text: text to match.
+     * @param simulated: holds the accepted ids if the text reaches a state not built.
+     * @param count: set to the number of accepted patterns.
+     */
+    const std::uint32_t* runAutomaton(const ConstContiguousView<char>& text, std::vector<std::uint32_t>& simulated,
+                                      std::size_t& count) const;
+
+    /**
+     * Matches the rest of the text from a set of positions, storing the accepted ids in
+     * simulated.
+     */
+    const std::uint32_t* simulate(const std::vector<std::uint32_t>& positions, const ConstContiguousView<char>& text,
+                                  std::size_t from, std::vector<std::uint32_t>& simulated, std::size_t& count) const;
+
+    std::size_t _patterns;                                 // Number of patterns
+    detail::GlobLiteralTrie _prefixes;                     // Literal and literal* patterns
+    detail::GlobLiteralTrie _suffixes;                     // *literal patterns, reversed
+    std::array<std::uint16_t, 256> _classes;               // Input class of each byte
+    std::uint32_t _classCount;                             // Number of input classes
+    std::uint32_t _start;                                  // Premultiplied start state. 0 is the dead state
+    std::uint32_t _builtLimit;                             // Next states from this one are _pending ones
+    std::vector<std::uint32_t> _transitions;               // Premultiplied next state, per state and input class
+    std::vector<std::uint32_t> _acceptBegin;               // Range of _accepts of each state
+    std::vector<std::uint32_t> _accepts;                   // Ids of the patterns accepted at each state
+    std::vector<detail::GlobPosition> _positions;          // Positions of the patterns, if some states were not built
+    std::vector<std::vector<std::uint32_t>> _pending;      // Positions of the states reached but not built
+
+}; // class GlobMatcher
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_GLOBMATCHER_HPP
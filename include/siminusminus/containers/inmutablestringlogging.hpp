@@ -0,0 +1,128 @@
+#ifndef SIMINUSMINUS_CONTAINERS_INMUTABLESTRINGLOGGING_HPP
+#define SIMINUSMINUS_CONTAINERS_INMUTABLESTRINGLOGGING_HPP
+
+#include <siminusminus/utils/debugutilities.hpp>
+#include <siminusminus/utils/tracing.hpp>
+#include <cstddef>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \defgroup inmutablestringlogging InmutableString logging policies
+ * \ingroup containers
+ *
+ * Logging policies decide what a BasicInmutableString reports about its life cycle.
+ * A logging policy is a class with two static functions and a type:
+ *
+ *  - `log(const char* message)`: called on construction, destruction and assignment.
+ *  - `logString(const CharT* data, std::size_t length)`: called with the contents of
+ *    a string after it is created.
+ *  - `Scope`: constructible from a `const char*` name. The constructors that copy
+ *    characters and the concatenation keep one alive while they run.
+ */
+
+/**
+ * \ingroup inmutablestringlogging
+ * \brief Scope type of the policies that do not measure anything.
+ */
+struct NoScope
+{
+    explicit NoScope(const char*) {}
+};
+
+/**
+ * \ingroup inmutablestringlogging
+ * \brief Logs through DebugUtilities on debug builds, does nothing on release builds.
+ *
+ * This is the logging policy of InmutableString.
+ */
+struct DebugLogging
+{
+    typedef NoScope Scope;
+
+    static void log(const char* message)
+    {
+    #ifndef NDEBUG
+        utils::DebugUtilities::log(message);
+    #else
+        (void)message;
+    #endif
+    }
+
+    static void logString(const char* data, std::size_t length)
+    {
+    #ifndef NDEBUG
+        logContents(data, length);
+    #else
+        (void)data;
+        (void)length;
+    #endif
+    }
+
+    template <typename CharT>
+    static void logString(const CharT*, std::size_t length)
+    {
+    #ifndef NDEBUG
+        logContents(nullptr, length);
+    #else
+        (void)length;
+    #endif
+    }
+
+private:
+
+    /**
+     * Logs the string (if any) and its length.
+     */
+    static void logContents(const char* data, std::size_t length);
+};
+
+/**
+ * \ingroup inmutablestringlogging
+ * \brief Logs nothing.
+ */
+struct NoLogging
+{
+    typedef NoScope Scope;
+
+    static void log(const char*) {}
+
+    template <typename CharT>
+    static void logString(const CharT*, std::size_t) {}
+};
+
+/**
+ * \ingroup inmutablestringlogging
+ * \brief Records the construction and concatenation of strings as utils::Tracer spans.
+ *
+ * Strings using this policy show up in the traces of the Tracer, while it is recording.
+ * For example:
+ *
+ * ``` cpp
+ * typedef cmm::containers::BasicInmutableString<cmm::containers::HeapStorage,
+ *                                               cmm::containers::TracingLogging,
+ *                                               char> TracedString;
+ * ```
+ *
+ * Nothing else is logged, and nothing at all when SIMINUSMINUS_TRACING is not defined:
+ * the policy then costs as much as NoLogging.
+ */
+struct TracingLogging
+{
+#ifdef SIMINUSMINUS_TRACING
+    typedef utils::TraceScope Scope;
+#else
+    typedef NoScope Scope;
+#endif
+
+    static void log(const char*) {}
+
+    template <typename CharT>
+    static void logString(const CharT*, std::size_t) {}
+};
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_INMUTABLESTRINGLOGGING_HPP
@@ -0,0 +1,503 @@
+#ifndef SIMINUSMINUS_CONTAINERS_INMUTABLESTRINGSTORAGE_HPP
+#define SIMINUSMINUS_CONTAINERS_INMUTABLESTRINGSTORAGE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \defgroup inmutablestringstorage InmutableString storage policies
+ * \ingroup containers
+ *
+ * Storage policies decide where the characters of a BasicInmutableString live.
+ * A storage policy is a class template on the character type that provides:
+ *
+ *  - A default constructor creating the empty string.
+ *  - Copy and move constructors and assignment operators. A moved-from storage is empty.
+ *  - `CharT* allocate(std::size_t length)`: replaces the contents of the storage with
+ *    length uninitialized characters followed by the end character, and returns the
+ *    characters so the string can fill them.
+ *  - `const CharT* data() const` and `std::size_t length() const`.
+ *
+ * data() never returns nullptr and the characters are always followed by CharT().
+ */
+
+namespace detail {
+
+/**
+ * Storage of the empty string shared by all the storage policies.
+ */
+template <typename CharT>
+struct EmptyString
+{
+    static const CharT value[1];
+};
+
+template <typename CharT>
+const CharT EmptyString<CharT>::value[1] = {CharT()};
+
+} // namespace detail
+
+/**
+ * \ingroup inmutablestringstorage
+ * \brief Each string owns a heap allocation with its characters.
+ *
+ * This is the storage of InmutableString. Copies allocate.
+ */
+template <typename CharT>
+class HeapStorage
+{
+public:
+
+    HeapStorage(): _data(detail::EmptyString<CharT>::value), _length(0) {}
+
+    HeapStorage(const HeapStorage& other): HeapStorage()
+    {
+        std::memcpy(allocate(other._length), other._data, other._length * sizeof(CharT));
+    }
+
+    HeapStorage(HeapStorage&& other) noexcept: _data(other._data), _length(other._length)
+    {
+        other._data = detail::EmptyString<CharT>::value;
+        other._length = 0;
+    }
+
+    HeapStorage& operator=(HeapStorage other) noexcept
+    {
+        std::swap(_data, other._data);
+        std::swap(_length, other._length);
+
+        return *this;
+    }
+
+    ~HeapStorage()
+    {
+        release();
+    }
+
+    CharT* allocate(std::size_t length)
+    {
+        CharT* data = new CharT[length + 1];
+        data[length] = CharT();
+
+        release();
+        _data = data;
+        _length = length;
+
+        return data;
+    }
+
+    const CharT* data() const
+    {
+        return _data;
+    }
+
+    std::size_t length() const
+    {
+        return _length;
+    }
+
+private:
+
+    void release()
+    {
+        if (_data != detail::EmptyString<CharT>::value)
+            delete[] _data;
+    }
+
+    const CharT* _data;  // Characters, or the shared empty string
+    std::size_t _length; // Length of the string
+
+}; // class HeapStorage
+
+/**
+ * \ingroup inmutablestringstorage
+ * \brief Short strings are stored inside the string object, long ones on the heap.
+ *
+ * Strings of up to InlineCapacity characters do not allocate. data() is a plain
+ * member read in both cases, because the object keeps a pointer to wherever the
+ * characters are.
+ */
+template <typename CharT>
+class InlineStorage
+{
+public:
+
+    /**
+     * Longest string stored inline.
+     */
+    static const std::size_t InlineCapacity = 24 / sizeof(CharT) - 1;
+
+    InlineStorage(): _data(_buffer), _length(0)
+    {
+        _buffer[0] = CharT();
+    }
+
+    InlineStorage(const InlineStorage& other): InlineStorage()
+    {
+        std::memcpy(allocate(other._length), other._data, other._length * sizeof(CharT));
+    }
+
+    InlineStorage(InlineStorage&& other) noexcept: InlineStorage()
+    {
+        steal(other);
+    }
+
+    InlineStorage& operator=(const InlineStorage& other)
+    {
+        if (this != &other)
+            std::memcpy(allocate(other._length), other._data, other._length * sizeof(CharT));
+
+        return *this;
+    }
+
+    InlineStorage& operator=(InlineStorage&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            steal(other);
+        }
+
+        return *this;
+    }
+
+    ~InlineStorage()
+    {
+        release();
+    }
+
+    CharT* allocate(std::size_t length)
+    {
+        release();
+
+        CharT* data = length <= InlineCapacity ? _buffer : new CharT[length + 1];
+        data[length] = CharT();
+
+        _data = data;
+        _length = length;
+
+        return data;
+    }
+
+    const CharT* data() const
+    {
+        return _data;
+    }
+
+    std::size_t length() const
+    {
+        return _length;
+    }
+
+private:
+
+    void release()
+    {
+        if (_data != _buffer)
+            delete[] _data;
+
+        _data = _buffer;
+        _length = 0;
+    }
+
+    void steal(InlineStorage& other)
+    {
+        if (other._data == other._buffer)
+        {
+            std::memcpy(_buffer, other._buffer, (other._length + 1) * sizeof(CharT));
+            _data = _buffer;
+        }
+        else
+        {
+            _data = other._data;
+        }
+
+        _length = other._length;
+        other._data = other._buffer;
+        other._buffer[0] = CharT();
+        other._length = 0;
+    }
+
+    const CharT* _data;                     // _buffer or a heap allocation
+    std::size_t _length;                    // Length of the string
+    CharT _buffer[InlineCapacity + 1];      // Characters of short strings
+
+}; // class InlineStorage
+
+template <typename CharT>
+const std::size_t InlineStorage<CharT>::InlineCapacity;
+
+/**
+ * \ingroup inmutablestringstorage
+ * \brief Copies of a string share one reference counted allocation.
+ *
+ * Copying is a reference count increment, so strings can be passed around by value
+ * cheaply. The count is atomic, so copies may live in different threads.
+ */
+template <typename CharT>
+class SharedStorage
+{
+public:
+
+    SharedStorage(): _block(nullptr), _data(detail::EmptyString<CharT>::value), _length(0) {}
+
+    SharedStorage(const SharedStorage& other): _block(other._block), _data(other._data), _length(other._length)
+    {
+        if (_block != nullptr)
+            _block->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SharedStorage(SharedStorage&& other) noexcept: _block(other._block), _data(other._data), _length(other._length)
+    {
+        other._block = nullptr;
+        other._data = detail::EmptyString<CharT>::value;
+        other._length = 0;
+    }
+
+    SharedStorage& operator=(SharedStorage other) noexcept
+    {
+        std::swap(_block, other._block);
+        std::swap(_data, other._data);
+        std::swap(_length, other._length);
+
+        return *this;
+    }
+
+    ~SharedStorage()
+    {
+        release();
+    }
+
+    CharT* allocate(std::size_t length)
+    {
+        void* memory = ::operator new(sizeof(Block) + (length + 1) * sizeof(CharT));
+        Block* block = new (memory) Block();
+        CharT* data = reinterpret_cast<CharT*>(block + 1);
+        data[length] = CharT();
+
+        release();
+        _block = block;
+        _data = data;
+        _length = length;
+
+        return data;
+    }
+
+    const CharT* data() const
+    {
+        return _data;
+    }
+
+    std::size_t length() const
+    {
+        return _length;
+    }
+
+    /**
+     * Returns the number of strings sharing the characters, 0 for the empty string.
+     */
+    std::size_t useCount() const
+    {
+        return _block != nullptr ? _block->references.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+
+    struct Block // Followed by the characters in the same allocation
+    {
+        std::atomic<std::size_t> references{1};
+    };
+
+    void release()
+    {
+        if (_block != nullptr && _block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            _block->~Block();
+            ::operator delete(_block);
+        }
+    }
+
+    Block* _block;       // Shared allocation, nullptr for the empty string
+    const CharT* _data;  // Characters, inside _block
+    std::size_t _length; // Length of the string
+
+}; // class SharedStorage
+
+/**
+ * \ingroup containers
+ * \brief Bump allocator for ArenaStorage strings.
+ *
+ * Allocations are carved from big blocks and are only released all together, when
+ * the arena is destroyed. Each thread allocates from its current arena: the one of the
+ * innermost live StringArena::Scope, or a default arena owned by the thread.
+ * For example:
+ *
+ * ``` cpp
+ * cmm::containers::StringArena arena;
+ *
+ * {
+ *     cmm::containers::StringArena::Scope scope(arena);
+ *     ArenaString str = parseRecord(input); // Allocated from arena
+ * }
+ * ```
+ */
+class StringArena
+{
+public:
+
+    /**
+     * Scope making an arena the current arena of the thread.
+     */
+    class Scope
+    {
+    public:
+
+        /**
+         * Makes arena the current arena of the thread until the scope ends.
+         * @param arena: arena to allocate from.
+         */
+        explicit Scope(StringArena& arena);
+
+        /**
+         * Restores the previous current arena.
+         */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+
+        StringArena* _previous; // Current arena before the scope
+    };
+
+    /**
+     * Creates an empty arena.
+     * @param blockSize: size of the blocks requested to the heap.
+     */
+    explicit StringArena(std::size_t blockSize = 64 * 1024);
+
+    /**
+     * Releases all the memory of the arena.
+     */
+    ~StringArena();
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    /**
+     * Returns memory for size bytes aligned to alignment, which must be a power of two
+     * not greater than alignof(std::max_align_t).
+     * @param size: number of bytes.
+     * @param alignment: required alignment.
+     */
+    void* allocate(std::size_t size, std::size_t alignment)
+    {
+        std::size_t offset = (_used + alignment - 1) & ~(alignment - 1);
+
+        if (_current == nullptr || offset + size > _capacity)
+            return allocateSlow(size);
+
+        _used = offset + size;
+        return _current + offset;
+    }
+
+    /**
+     * Returns the number of bytes requested to the heap.
+     */
+    std::size_t capacity() const;
+
+    /**
+     * Returns the arena the calling thread allocates from.
+     */
+    static StringArena& current();
+
+private:
+
+    /**
+     * Starts a new block, big enough for size bytes, and allocates from it.
+     */
+    void* allocateSlow(std::size_t size);
+
+    std::vector<char*> _blocks; // Blocks requested to the heap
+    std::size_t _blockSize;     // Default size of the blocks
+    char* _current;             // Block being carved
+    std::size_t _used;          // Bytes used of the current block
+    std::size_t _capacity;      // Size of the current block
+    std::size_t _total;         // Bytes of all the blocks
+
+}; // class StringArena
+
+/**
+ * \ingroup inmutablestringstorage
+ * \brief Strings are allocated from the current StringArena of the thread.
+ *
+ * Allocation is a pointer bump and destruction does nothing. Copies share the
+ * characters. Strings must not outlive the arena they were allocated from.
+ */
+template <typename CharT>
+class ArenaStorage
+{
+public:
+
+    ArenaStorage(): _data(detail::EmptyString<CharT>::value), _length(0) {}
+
+    ArenaStorage(const ArenaStorage& other) = default;
+
+    ArenaStorage(ArenaStorage&& other) noexcept: _data(other._data), _length(other._length)
+    {
+        other._data = detail::EmptyString<CharT>::value;
+        other._length = 0;
+    }
+
+    ArenaStorage& operator=(const ArenaStorage& other) = default;
+
+    ArenaStorage& operator=(ArenaStorage&& other) noexcept
+    {
+        _data = other._data;
+        _length = other._length;
+        other._data = detail::EmptyString<CharT>::value;
+        other._length = 0;
+
+        return *this;
+    }
+
+    CharT* allocate(std::size_t length)
+    {
+        CharT* data = static_cast<CharT*>(StringArena::current().allocate((length + 1) * sizeof(CharT), alignof(CharT)));
+        data[length] = CharT();
+
+        _data = data;
+        _length = length;
+
+        return data;
+    }
+
+    const CharT* data() const
+    {
+        return _data;
+    }
+
+    std::size_t length() const
+    {
+        return _length;
+    }
+
+private:
+
+    const CharT* _data;  // Characters, inside an arena block
+    std::size_t _length; // Length of the string
+
+}; // class ArenaStorage
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_INMUTABLESTRINGSTORAGE_HPP
@@ -0,0 +1,187 @@
+#ifndef SIMINUSMINUS_CONTAINERS_NUMERICCONVERSIONS_HPP
+#define SIMINUSMINUS_CONTAINERS_NUMERICCONVERSIONS_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/containers/inmutablestring.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \ingroup containers
+ * \brief Errors reported by the numeric parsers.
+ */
+enum class ParseError
+{
+    None,         // The number was parsed
+    InvalidInput, // The text does not start with a number
+    OutOfRange    // The number does not fit in the requested type
+};
+
+/**
+ * \ingroup containers
+ * \brief Result of a numeric parser.
+ *
+ * Like std::from_chars, the parsers read the longest prefix of the text that forms
+ * a number. The value is only meaningful if error is ParseError::None.
+ */
+template <typename T>
+struct ParseResult
+{
+    T value;              // Parsed value
+    std::size_t consumed; // Characters read. 0 on ParseError::InvalidInput
+    ParseError error;     // What went wrong, if anything
+};
+
+/**
+ * \ingroup containers
+ * \brief Buffer sizes needed by writeInteger() and writeFloatingPoint().
+ */
+struct NumericBufferSize
+{
+    static const std::size_t Integer = 20;       // "-9223372036854775808", "18446744073709551615"
+    static const std::size_t FloatingPoint = 24; // "-2.2250738585072014e-308"
+};
+
+namespace detail {
+
+/**
+ * Reads the decimal digits at the start of [first, last) into value, eight digits at a
+ * time when possible. Returns the end of the digits; overflow is set if they do not
+ * fit in 64 bits.
+ */
+const char* parseDigits(const char* first, const char* last, std::uint64_t& value, bool& overflow);
+
+/**
+ * Writes the decimal digits of value to out and returns the end of the digits.
+ */
+char* writeDigits(char* out, std::uint64_t value);
+
+} // namespace detail
+
+/**
+ * \ingroup containers
+ * Parses a decimal integer from the start of the text. A leading '-' is accepted for
+ * signed types only. Leading whitespace and '+' are not accepted.
+ * For example:
+ *
+ * ``` cpp
+ * auto result = cmm::containers::parseInteger<int>(record.view());
+ *
+ * if (result.error == cmm::containers::ParseError::None)
+ *     std::cout << result.value;
+ * ```
+ * @param text: text to parse.
+ */
+template <typename T>
+ParseResult<T> parseInteger(const ConstContiguousView<char>& text)
+{
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value, "parseInteger() requires an integer type");
+
+    const char* first = text.data();
+    const char* const last = first + text.size();
+    const bool negative = std::is_signed<T>::value && first != last && *first == '-';
+
+    if (negative)
+        ++first;
+
+    std::uint64_t magnitude = 0;
+    bool overflow = false;
+    const char* const end = detail::parseDigits(first, last, magnitude, overflow);
+
+    if (end == first)
+        return ParseResult<T>{T(), 0, ParseError::InvalidInput};
+
+    const std::size_t consumed = static_cast<std::size_t>(end - text.data());
+    const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+
+    if (overflow || magnitude > limit)
+        return ParseResult<T>{T(), consumed, ParseError::OutOfRange};
+
+    if (negative && magnitude != 0) // Written this way so the most negative value does not overflow
+        return ParseResult<T>{static_cast<T>(-static_cast<T>(magnitude - 1) - 1), consumed, ParseError::None};
+
+    return ParseResult<T>{static_cast<T>(magnitude), consumed, ParseError::None};
+}
+
+/**
+ * \ingroup containers
+ * Parses a decimal floating point number (float or double) from the start of the text:
+ * an optional '-', digits with an optional '.', and an optional exponent. "inf", "infinity"
+ * and "nan" are accepted in any case. The result is correctly rounded.
+ * @param text: text to parse.
+ */
+template <typename T>
+ParseResult<T> parseFloatingPoint(const ConstContiguousView<char>& text);
+
+/**
+ * \ingroup containers
+ * Writes the decimal representation of value to out, which must have room for
+ * NumericBufferSize::Integer characters. No '\0' is written.
+ * Returns the end of the written characters.
+ * @param out: output buffer.
+ * @param value: integer to write.
+ */
+template <typename T>
+char* writeInteger(char* out, T value)
+{
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value, "writeInteger() requires an integer type");
+
+    if (value < T())
+    {
+        *out++ = '-';
+        return detail::writeDigits(out, static_cast<std::uint64_t>(-(value + 1)) + 1);
+    }
+
+    return detail::writeDigits(out, static_cast<std::uint64_t>(value));
+}
+
+/**
+ * \ingroup containers
+ * Writes the shortest decimal representation of value (float or double) that parses back
+ * to the same value to out, which must have room for NumericBufferSize::FloatingPoint
+ * characters. No '\0' is written. Returns the end of the written characters.
+ *
+ * The digits are generated with Grisu3 and do not depend on the locale. The few values
+ * Grisu3 cannot decide fall back to printf in the "C" locale, which is much slower. The
+ * layout is the one of "%g" with as many significant digits as needed (at least
+ * std::numeric_limits<T>::digits10): 0.1, 1e+100, 0.30000000000000004.
+ * @param out: output buffer.
+ * @param value: number to write.
+ */
+template <typename T>
+char* writeFloatingPoint(char* out, T value);
+
+/**
+ * \ingroup containers
+ * Returns the decimal representation of an integer.
+ * @param value: integer to format.
+ */
+template <typename T>
+InmutableString formatInteger(T value)
+{
+    char buffer[NumericBufferSize::Integer];
+    return InmutableString(ConstContiguousView<char>(buffer, writeInteger(buffer, value)));
+}
+
+/**
+ * \ingroup containers
+ * Returns the shortest decimal representation of value (float or double) that parses back
+ * to the same value.
+ * @param value: number to format.
+ */
+template <typename T>
+InmutableString formatFloatingPoint(T value)
+{
+    char buffer[NumericBufferSize::FloatingPoint];
+    return InmutableString(ConstContiguousView<char>(buffer, writeFloatingPoint(buffer, value)));
+}
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_NUMERICCONVERSIONS_HPP
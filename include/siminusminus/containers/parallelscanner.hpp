@@ -0,0 +1,146 @@
+#ifndef SIMINUSMINUS_CONTAINERS_PARALLELSCANNER_HPP
+#define SIMINUSMINUS_CONTAINERS_PARALLELSCANNER_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/utils/threadpool.hpp>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \ingroup containers
+ * \brief Runs scanning kernels over a view using all the threads of a pool.
+ *
+ * The view is split in chunks whose boundaries are aligned to cache lines, so two
+ * threads never read the same line. Each chunk is processed by a kernel and the
+ * results of the chunks are merged in order. For example:
+ *
+ * ``` cpp
+ * cmm::utils::ThreadPool pool;
+ * cmm::containers::ParallelScanner scanner(pool);
+ *
+ * auto newLines = scanner.count(log.view(), '\n');
+ * auto firstError = scanner.findFirst(log.view(), errorTag.view());
+ * ```
+ *
+ * The kernels read each byte once and do little work per byte, so they are limited by
+ * memory bandwidth: adding threads stops helping once a few cores saturate it, well
+ * before the pool runs out of threads. Each call also pays for one parallelFor on the
+ * pool and, in reduce(), for combining one result per chunk (a 2 KiB table for the
+ * histogram), so views of only a few chunks are not faster than a sequential scan.
+ * findFirst() skips the chunks after an occurrence that is already known, but chunks
+ * already running are finished.
+ */
+class ParallelScanner
+{
+public:
+
+    /**
+     * Value returned by the find functions when there is no occurrence.
+     */
+    static const std::size_t NotFound = static_cast<std::size_t>(-1);
+
+    /**
+     * Default size of the chunks, in bytes.
+     */
+    static const std::size_t DefaultChunkSize = 1 << 20;
+
+    /**
+     * Creates a scanner running on the given pool.
+     * @param pool: pool the kernels run on. It must outlive the scanner.
+     * @param chunkSize: approximate size of the chunks, rounded up to a multiple of the cache line size.
+     */
+    ParallelScanner(utils::ThreadPool& pool, std::size_t chunkSize = DefaultChunkSize);
+
+    /**
+     * Returns the number of occurrences of a byte in the view.
+     * @param view: view to scan.
+     * @param byte: byte to count.
+     */
+    std::size_t count(const ConstContiguousView<char>& view, char byte) const;
+
+    /**
+     * Returns the offset of the first occurrence of a byte in the view, or NotFound.
+     * @param view: view to scan.
+     * @param byte: byte to look for.
+     */
+    std::size_t findFirst(const ConstContiguousView<char>& view, char byte) const;
+
+    /**
+     * Returns the offset of the first occurrence of needle in the view, or NotFound.
+     * Occurrences crossing chunk boundaries are found too.
+     * @param view: view to scan.
+     * @param needle: sequence to look for. An empty needle is found at offset 0.
+     */
+    std::size_t findFirst(const ConstContiguousView<char>& view, const ConstContiguousView<char>& needle) const;
+
+    /**
+     * Returns the offsets of all the occurrences of needle in the view, in increasing
+     * order. Overlapping occurrences are reported.
+     * @param view: view to scan.
+     * @param needle: sequence to look for. It must not be empty.
+     */
+    std::vector<std::size_t> findAll(const ConstContiguousView<char>& view, const ConstContiguousView<char>& needle) const;
+
+    /**
+     * Returns the number of occurrences of each byte value in the view.
+     * @param view: view to scan.
+     */
+    std::array<std::size_t, 256> histogram(const ConstContiguousView<char>& view) const;
+
+    /**
+     * Computes kernel(chunk) for each chunk of the view and folds the results in
+     * chunk order with combine(accumulated, chunkResult), starting from identity.
+     * combine must be associative, but it does not need to be commutative.
+     * @param view: view to scan.
+     * @param identity: initial value of the fold, also the value for empty views.
+     * @param kernel: function from ConstContiguousView<char> to T.
+     * @param combine: function from (T, T) to T.
+     */
+    template <typename T, typename Kernel, typename Combine>
+    T reduce(const ConstContiguousView<char>& view, T identity, Kernel kernel, Combine combine) const
+    {
+        struct Slot // Avoids the packed std::vector<bool>, which cannot be written in parallel
+        {
+            T value;
+        };
+
+        const std::vector<ConstContiguousView<char>> parts = chunks(view);
+        std::vector<Slot> results(parts.size(), Slot{identity});
+
+        _pool.parallelFor(parts.size(), [&](std::size_t i)
+        {
+            results[i].value = kernel(parts[i]);
+        });
+
+        for (const Slot& result : results)
+            identity = combine(identity, result.value);
+
+        return identity;
+    }
+
+    /**
+     * Returns the chunks the view is split into.
+     * @param view: view to split.
+     */
+    std::vector<ConstContiguousView<char>> chunks(const ConstContiguousView<char>& view) const;
+
+    /**
+     * Returns the size of the chunks.
+     */
+    std::size_t chunkSize() const;
+
+private:
+
+    utils::ThreadPool& _pool; // Pool the kernels run on
+    std::size_t _chunkSize;   // Size of the chunks, multiple of the cache line size
+
+}; // class ParallelScanner
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_PARALLELSCANNER_HPP
@@ -0,0 +1,385 @@
+#ifndef SIMINUSMINUS_CONTAINERS_SKETCHES_HPP
+#define SIMINUSMINUS_CONTAINERS_SKETCHES_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/containers/inmutablestring.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \ingroup containers
+ * Returns the 64 bit hash of a key used by the sketches. Hash a key once and pass the
+ * result to the *Hash() functions of each sketch fed with it.
+ * @param key: bytes to hash.
+ */
+std::uint64_t hashKey(const ConstContiguousView<char>& key);
+
+namespace detail {
+
+/**
+ * Array of words whose first one is aligned to a cache line.
+ */
+class CacheAlignedWords
+{
+public:
+
+    explicit CacheAlignedWords(std::size_t count = 0);
+    CacheAlignedWords(const CacheAlignedWords& other);
+    CacheAlignedWords(CacheAlignedWords&& other) = default;
+    CacheAlignedWords& operator=(const CacheAlignedWords& other);
+    CacheAlignedWords& operator=(CacheAlignedWords&& other) = default;
+
+    std::uint64_t* data();
+    const std::uint64_t* data() const;
+    std::size_t size() const;
+
+private:
+
+    std::vector<std::uint64_t> _storage; // Words, with room to align the first one
+    std::size_t _count;                  // Number of aligned words
+
+}; // class CacheAlignedWords
+
+} // namespace detail
+
+/**
+ * \ingroup containers
+ * \brief Blocked Bloom filter: set membership with false positives and no false negatives.
+ *
+ * Each key sets all its bits inside a single 64 byte block, so inserting and looking up
+ * a key touch one cache line. For example:
+ *
+ * ``` cpp
+ * cmm::containers::BloomFilter seen(1 << 20); // 1 MiB
+ *
+ * if (!seen.mayContain(key.view()))
+ * {
+ *     seen.insert(key.view());
+ *     process(key);
+ * }
+ * ```
+ *
+ * Filters with the same size and number of hashes can be merged, so each thread can
+ * fill its own filter.
+ */
+class BloomFilter
+{
+public:
+
+    /**
+     * Bits set per key by default.
+     */
+    static const std::size_t DefaultHashes = 8;
+
+    /**
+     * Creates an empty filter.
+     * @param bytes: size of the filter, rounded up to a multiple of 64 bytes.
+     * @param hashes: bits set per key, at least one.
+     */
+    explicit BloomFilter(std::size_t bytes, std::size_t hashes = DefaultHashes);
+
+    /**
+     * Adds a key to the filter.
+     * @param key: key to add.
+     */
+    void insert(const ConstContiguousView<char>& key);
+
+    /**
+     * insert() for a key held by an InmutableString.
+     * @param key: key to add.
+     */
+    template <template <typename> class StoragePolicy, typename LoggingPolicy>
+    void insert(const BasicInmutableString<StoragePolicy, LoggingPolicy, char>& key)
+    {
+        insert(key.view());
+    }
+
+    /**
+     * Adds a key given its hashKey() to the filter.
+     * @param hash: hash of the key.
+     */
+    void insertHash(std::uint64_t hash);
+
+    /**
+     * Returns false if the key was never added, and true if it probably was.
+     * @param key: key to look for.
+     */
+    bool mayContain(const ConstContiguousView<char>& key) const;
+
+    /**
+     * mayContain() for a key held by an InmutableString.
+     * @param key: key to look for.
+     */
+    template <template <typename> class StoragePolicy, typename LoggingPolicy>
+    bool mayContain(const BasicInmutableString<StoragePolicy, LoggingPolicy, char>& key) const
+    {
+        return mayContain(key.view());
+    }
+
+    /**
+     * mayContain() for a key given its hashKey().
+     * @param hash: hash of the key.
+     */
+    bool mayContainHash(std::uint64_t hash) const;
+
+    /**
+     * Adds the keys of another filter. Returns false, doing nothing, if the filters
+     * have different sizes or numbers of hashes.
+     * @param other: filter to merge.
+     */
+    bool merge(const BloomFilter& other);
+
+    /**
+     * Appends the filter to bytes. Returns the number of bytes appended.
+     * @param bytes: output buffer.
+     */
+    std::size_t serialize(std::vector<char>& bytes) const;
+
+    /**
+     * Replaces the filter with a serialized one. Returns false, leaving the filter
+     * unchanged, if the bytes are not a serialized filter.
+     * @param bytes: output of serialize().
+     */
+    bool deserialize(const ConstContiguousView<char>& bytes);
+
+    /**
+     * Returns the size of the filter in bytes.
+     */
+    std::size_t sizeInBytes() const;
+
+private:
+
+    std::size_t _blocks;              // Number of 64 byte blocks
+    std::size_t _hashes;              // Bits set per key
+    detail::CacheAlignedWords _words; // Bits of the filter, 8 words per block
+
+}; // class BloomFilter
+
+/**
+ * \ingroup containers
+ * \brief HyperLogLog estimator of the number of distinct keys.
+ *
+ * The sketch keeps 2^precision registers of one byte, and its estimates have a standard
+ * error of about 1.04 / sqrt(2^precision): 0.8% with the default precision, in 16 KiB.
+ * For example:
+ *
+ * ``` cpp
+ * cmm::containers::HyperLogLog distinct;
+ *
+ * for (const auto& key : window)
+ *     distinct.insert(key.view());
+ *
+ * std::cout << distinct.estimate() << " distinct keys" << std::endl;
+ * ```
+ *
+ * Sketches with the same precision can be merged.
+ */
+class HyperLogLog
+{
+public:
+
+    /**
+     * Precision used by default.
+     */
+    static const unsigned int DefaultPrecision = 14;
+
+    /**
+     * Smallest and largest precisions. Other values are clamped to this range.
+     */
+    static const unsigned int MinPrecision = 4;
+    static const unsigned int MaxPrecision = 18;
+
+    /**
+     * Creates an empty sketch.
+     * @param precision: base 2 logarithm of the number of registers.
+     */
+    explicit HyperLogLog(unsigned int precision = DefaultPrecision);
+
+    /**
+     * Counts a key.
+     * @param key: key to count.
+     */
+    void insert(const ConstContiguousView<char>& key);
+
+    /**
+     * insert() for a key held by an InmutableString.
+     * @param key: key to count.
+     */
+    template <template <typename> class StoragePolicy, typename LoggingPolicy>
+    void insert(const BasicInmutableString<StoragePolicy, LoggingPolicy, char>& key)
+    {
+        insert(key.view());
+    }
+
+    /**
+     * Counts a key given its hashKey().
+     * @param hash: hash of the key.
+     */
+    void insertHash(std::uint64_t hash);
+
+    /**
+     * Returns the estimated number of distinct keys counted.
+     */
+    double estimate() const;
+
+    /**
+     * Counts the keys of another sketch. Returns false, doing nothing, if the sketches
+     * have different precisions.
+     * @param other: sketch to merge.
+     */
+    bool merge(const HyperLogLog& other);
+
+    /**
+     * Appends the sketch to bytes. Returns the number of bytes appended.
+     * @param bytes: output buffer.
+     */
+    std::size_t serialize(std::vector<char>& bytes) const;
+
+    /**
+     * Replaces the sketch with a serialized one. Returns false, leaving the sketch
+     * unchanged, if the bytes are not a serialized sketch.
+     * @param bytes: output of serialize().
+     */
+    bool deserialize(const ConstContiguousView<char>& bytes);
+
+    /**
+     * Returns the precision of the sketch.
+     */
+    unsigned int precision() const;
+
+private:
+
+    unsigned int _precision;              // Base 2 logarithm of the number of registers
+    std::vector<std::uint8_t> _registers; // Highest rank seen by each register
+
+}; // class HyperLogLog
+
+/**
+ * \ingroup containers
+ * \brief Count-min sketch: approximate count of each key.
+ *
+ * Estimates are never below the real counts. With a width w, they exceed them by less
+ * than e / w times the total count with probability 1 - e^-depth. For example:
+ *
+ * ``` cpp
+ * cmm::containers::CountMinSketch hits(4096, 4);
+ *
+ * for (const auto& request : requests)
+ *     hits.insert(request.path);
+ *
+ * std::cout << hits.estimate(home.view()) << " hits" << std::endl;
+ * ```
+ *
+ * Sketches with the same width and depth can be merged.
+ */
+class CountMinSketch
+{
+public:
+
+    /**
+     * Creates an empty sketch. Throws std::length_error if the rounded width or the
+     * number of counters do not fit in a std::size_t.
+     * @param width: counters per row, rounded up to a power of two.
+     * @param depth: number of rows, at least one.
+     */
+    CountMinSketch(std::size_t width, std::size_t depth);
+
+    /**
+     * Adds count occurrences of a key.
+     * @param key: key to count.
+     * @param count: number of occurrences.
+     */
+    void insert(const ConstContiguousView<char>& key, std::uint64_t count = 1);
+
+    /**
+     * insert() for a key held by an InmutableString.
+     * @param key: key to count.
+     * @param count: number of occurrences.
+     */
+    template <template <typename> class StoragePolicy, typename LoggingPolicy>
+    void insert(const BasicInmutableString<StoragePolicy, LoggingPolicy, char>& key, std::uint64_t count = 1)
+    {
+        insert(key.view(), count);
+    }
+
+    /**
+     * Adds count occurrences of a key given its hashKey().
+     * @param hash: hash of the key.
+     * @param count: number of occurrences.
+     */
+    void insertHash(std::uint64_t hash, std::uint64_t count = 1);
+
+    /**
+     * Returns the estimated number of occurrences of a key.
+     * @param key: key to look for.
+     */
+    std::uint64_t estimate(const ConstContiguousView<char>& key) const;
+
+    /**
+     * estimate() for a key held by an InmutableString.
+     * @param key: key to look for.
+     */
+    template <template <typename> class StoragePolicy, typename LoggingPolicy>
+    std::uint64_t estimate(const BasicInmutableString<StoragePolicy, LoggingPolicy, char>& key) const
+    {
+        return estimate(key.view());
+    }
+
+    /**
+     * estimate() for a key given its hashKey().
+     * @param hash: hash of the key.
+     */
+    std::uint64_t estimateHash(std::uint64_t hash) const;
+
+    /**
+     * Returns the sum of the counts of all the keys.
+     */
+    std::uint64_t total() const;
+
+    /**
+     * Adds the counts of another sketch. Returns false, doing nothing, if the sketches
+     * have different widths or depths.
+     * @param other: sketch to merge.
+     */
+    bool merge(const CountMinSketch& other);
+
+    /**
+     * Appends the sketch to bytes. Returns the number of bytes appended.
+     * @param bytes: output buffer.
+     */
+    std::size_t serialize(std::vector<char>& bytes) const;
+
+    /**
+     * Replaces the sketch with a serialized one. Returns false, leaving the sketch
+     * unchanged, if the bytes are not a serialized sketch.
+     * @param bytes: output of serialize().
+     */
+    bool deserialize(const ConstContiguousView<char>& bytes);
+
+    /**
+     * Returns the number of counters per row.
+     */
+    std::size_t width() const;
+
+    /**
+     * Returns the number of rows.
+     */
+    std::size_t depth() const;
+
+private:
+
+    std::size_t _width;                   // Counters per row, a power of two
+    std::size_t _depth;                   // Number of rows
+    std::uint64_t _total;                 // Sum of all the counts
+    std::vector<std::uint64_t> _counters; // Counters, row by row
+
+}; // class CountMinSketch
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_SKETCHES_HPP
@@ -0,0 +1,183 @@
+#ifndef SIMINUSMINUS_CONTAINERS_STRINGSINK_HPP
+#define SIMINUSMINUS_CONTAINERS_STRINGSINK_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/containers/inmutablestring.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \ingroup containers
+ * \brief Batched output of strings to a file descriptor.
+ *
+ * The StringSink gathers strings into batches of buffers and writes each batch with
+ * a single writev() call. Long strings are not copied: the batch points to their
+ * characters. Short strings are copied into a staging buffer, where consecutive ones
+ * become a single buffer. Only the given length of each string is written, there is
+ * no need for a terminating null character. For example:
+ *
+ * ``` cpp
+ * cmm::containers::StringSink sink(fd);
+ *
+ * for (const cmm::containers::InmutableString& line : lines)
+ * {
+ *     sink.write(line);
+ *     sink.write(newline);
+ * }
+ *
+ * sink.flush();
+ * ```
+ *
+ * Borrowed strings (views and lvalue strings) must stay alive until the next call to
+ * flush() returns. Strings given as rvalues are kept by the sink until written.
+ * In Background mode, full batches are written by a flusher thread while the caller
+ * keeps filling the next one.
+ *
+ * Write errors are not reported by write(): the first one stops the output and is
+ * returned by error().
+ */
+class StringSink
+{
+public:
+
+    /**
+     * How full batches are written.
+     */
+    enum class Mode
+    {
+        Synchronous, // By the thread filling the batch
+        Background   // By a flusher thread owned by the sink
+    };
+
+    /**
+     * Default size in bytes of the staging buffer of each batch.
+     */
+    static const std::size_t DefaultStagingSize = 64 * 1024;
+
+    /**
+     * Default length up to which strings are copied into the staging buffer.
+     */
+    static const std::size_t DefaultCoalesceLimit = 512;
+
+    /**
+     * Creates a sink writing to a file descriptor. The descriptor is not closed by
+     * the sink.
+     * @param fd: file descriptor written to.
+     * @param mode: how full batches are written.
+     * @param stagingSize: size in bytes of the staging buffer of each batch.
+     * @param coalesceLimit: strings up to this length are copied into the staging buffer.
+     */
+    explicit StringSink(int fd, Mode mode = Mode::Synchronous,
+                        std::size_t stagingSize = DefaultStagingSize,
+                        std::size_t coalesceLimit = DefaultCoalesceLimit);
+
+    /**
+     * Flushes the pending strings and stops the flusher thread, if any.
+     */
+    ~StringSink();
+
+    StringSink(const StringSink&) = delete;
+    StringSink& operator=(const StringSink&) = delete;
+
+    /**
+     * Queues the characters of a view. They must stay valid until the next flush().
+     * @param view: characters to write.
+     */
+    void write(const ConstContiguousView<char>& view);
+
+    /**
+     * Queues the characters of a string. The string must stay alive until the next flush().
+     * @param str: string to write.
+     */
+    template <template <typename> class StoragePolicy, typename LoggingPolicy>
+    void write(const BasicInmutableString<StoragePolicy, LoggingPolicy, char>& str)
+    {
+        write(str.view());
+    }
+
+    /**
+     * Queues a string, which is kept by the sink until written.
+     * @param str: string to write.
+     */
+    void write(InmutableString&& str);
+
+    /**
+     * Queues a string of another type. Strings too long to be staged are copied into
+     * an InmutableString kept by the sink until written, since moving other storages
+     * may move their characters.
+     * @param str: string to write.
+     */
+    template <template <typename> class StoragePolicy, typename LoggingPolicy>
+    void write(BasicInmutableString<StoragePolicy, LoggingPolicy, char>&& str)
+    {
+        if (str.length() <= _coalesceLimit)
+            write(str.view());
+        else
+            write(InmutableString(str.view()));
+    }
+
+    /**
+     * Writes all the queued strings. Returns false if any write failed.
+     */
+    bool flush();
+
+    /**
+     * Returns the number of bytes written to the file descriptor so far.
+     */
+    std::size_t bytesWritten() const;
+
+    /**
+     * Returns the errno of the first failed write, or 0 if there were none.
+     */
+    int error() const;
+
+private:
+
+    struct Batch;
+
+    /**
+     * Writes the current batch, or hands it over to the flusher thread, and starts
+     * a new one.
+     */
+    void submit();
+
+    /**
+     * Writes a batch to the file descriptor.
+     */
+    void writeBatch(Batch& batch);
+
+    /**
+     * Loop of the flusher thread.
+     */
+    void flushBatches();
+
+    int _fd;                                    // File descriptor written to
+    Mode _mode;                                 // How full batches are written
+    std::size_t _stagingSize;                   // Staging buffer size of each batch
+    std::size_t _coalesceLimit;                 // Longest string copied into the staging buffer
+    std::unique_ptr<Batch> _current;            // Batch being filled
+    std::atomic<std::size_t> _bytesWritten;     // Bytes written so far
+    std::atomic<int> _error;                    // errno of the first failed write
+    std::deque<std::unique_ptr<Batch>> _full;   // Batches waiting for the flusher thread
+    std::vector<std::unique_ptr<Batch>> _spare; // Written batches, ready to be reused
+    std::mutex _mutex;                          // Guards the batch queues and _busy
+    std::condition_variable _changed;           // Signals queued, written batches or stop
+    bool _busy;                                 // Set while the flusher thread writes a batch
+    bool _stopping;                             // Set when the sink is being destroyed
+    std::thread _flusher;                       // Flusher thread, in Background mode
+
+}; // class StringSink
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_STRINGSINK_HPP
@@ -0,0 +1,177 @@
+#ifndef SIMINUSMINUS_CONTAINERS_SUFFIXINDEX_HPP
+#define SIMINUSMINUS_CONTAINERS_SUFFIXINDEX_HPP
+
+#include <siminusminus/containers/constcontiguousview.hpp>
+#include <siminusminus/utils/threadpool.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cmm {
+namespace containers {
+
+/**
+ * \ingroup containers
+ * \brief Range [begin, end) of the suffix array of a SuffixIndex.
+ */
+struct SuffixRange
+{
+    std::size_t begin; // First suffix starting with the pattern
+    std::size_t end;   // One past the last suffix starting with the pattern
+};
+
+/**
+ * \ingroup containers
+ * \brief Full-text index answering substring queries without scanning the text.
+ *
+ * The index keeps the suffix array of the text, built with the linear time SA-IS
+ * algorithm, and its LCP array, built with Kasai's algorithm. Queries binary search
+ * the suffix array, so each one takes O(m log n) for a pattern of length m. For example:
+ *
+ * ``` cpp
+ * cmm::utils::ThreadPool pool;
+ * cmm::containers::SuffixIndex index(logs.view(), pool);
+ * std::vector<std::size_t> offsets;
+ *
+ * index.findAll(timeout.view(), offsets);
+ * index.save("logs.index");
+ *
+ * cmm::containers::SuffixIndex mapped;
+ * mapped.open("logs.index"); // Maps the file, no need to build again
+ * ```
+ *
+ * An index built from a view does not copy the text, which must outlive the index.
+ * Saved indices hold a copy of the text, and open() maps the whole file read-only.
+ */
+class SuffixIndex
+{
+public:
+
+    /**
+     * Value returned by locate() when there is no occurrence.
+     */
+    static const std::size_t NotFound = static_cast<std::size_t>(-1);
+
+    /**
+     * Creates an empty index.
+     */
+    SuffixIndex();
+
+    /**
+     * Builds the index of a text.
+     * @param text: indexed text. It must outlive the index.
+     */
+    explicit SuffixIndex(const ConstContiguousView<char>& text);
+
+    /**
+     * Builds the index of a text. The LCP array is computed by the threads of the pool.
+     * @param text: indexed text. It must outlive the index.
+     * @param pool: pool used during the construction.
+     */
+    SuffixIndex(const ConstContiguousView<char>& text, utils::ThreadPool& pool);
+
+    /**
+     * Unmaps the index file, if any.
+     */
+    ~SuffixIndex();
+
+    SuffixIndex(const SuffixIndex&) = delete;
+    SuffixIndex& operator=(const SuffixIndex&) = delete;
+
+    /**
+     * Writes the text and the index to a file. Returns false if it could not be written.
+     * @param path: path of the file.
+     */
+    bool save(const char* path) const;
+
+    /**
+     * Replaces the index with one saved to a file, mapping it into memory. Returns false
+     * if the file can not be mapped or is not an index, leaving this index empty. Every
+     * entry of the arrays is checked once, so a corrupted file is rejected here instead
+     * of making the queries read outside the mapping.
+     * @param path: path of the file.
+     */
+    bool open(const char* path);
+
+    /**
+     * Returns the number of occurrences of a pattern in the text.
+     * @param pattern: sequence to look for.
+     */
+    std::size_t count(const ConstContiguousView<char>& pattern) const;
+
+    /**
+     * Returns the offset of an occurrence of a pattern, not necessarily the first
+     * one, or NotFound.
+     * @param pattern: sequence to look for.
+     */
+    std::size_t locate(const ConstContiguousView<char>& pattern) const;
+
+    /**
+     * Appends the offsets of all the occurrences of a pattern to offsets, in increasing
+     * order. Returns the number of occurrences.
+     * @param pattern: sequence to look for.
+     * @param offsets: output buffer.
+     */
+    std::size_t findAll(const ConstContiguousView<char>& pattern, std::vector<std::size_t>& offsets) const;
+
+    /**
+     * Returns the range of the suffix array whose suffixes start with a pattern.
+     * @param pattern: sequence to look for.
+     */
+    SuffixRange range(const ConstContiguousView<char>& pattern) const;
+
+    /**
+     * Returns the offset of the i-th suffix in lexicographical order.
+     * @param i: position in the suffix array.
+     */
+    std::size_t suffix(std::size_t i) const;
+
+    /**
+     * Returns the length of the longest common prefix of the i-th suffix and the
+     * previous one, or 0 for the first suffix.
+     * @param i: position in the suffix array.
+     */
+    std::size_t lcp(std::size_t i) const;
+
+    /**
+     * Returns the indexed text.
+     */
+    ConstContiguousView<char> text() const;
+
+    /**
+     * Returns the length of the indexed text.
+     */
+    std::size_t length() const;
+
+private:
+
+    /**
+     * Builds the suffix and LCP arrays of _text. pool may be null.
+     */
+    void build(utils::ThreadPool* pool);
+
+    /**
+     * Releases the mapped file, if any, and leaves the index empty.
+     */
+    void reset();
+
+    /**
+     * Compares the suffix starting at offset with a pattern, up to the length of the pattern.
+     */
+    int compare(std::size_t offset, const ConstContiguousView<char>& pattern) const;
+
+    const char* _text;                           // Indexed text
+    std::size_t _length;                         // Length of the text
+    const std::uint64_t* _suffixes;              // Suffix array
+    const std::uint64_t* _lcp;                   // LCP array
+    std::vector<std::uint64_t> _builtSuffixes;   // Suffix array of built indices
+    std::vector<std::uint64_t> _builtLcp;        // LCP array of built indices
+    void* _mapping;                              // Mapped index file, if opened
+    std::size_t _mappingSize;                    // Size of the mapping
+
+}; // class SuffixIndex
+
+} // namespace containers
+} // namespace cmm
+
+#endif // SIMINUSMINUS_CONTAINERS_SUFFIXINDEX_HPP
@@ -0,0 +1,113 @@
+#ifndef SIMINUSMINUS_UTILS_THREADPOOL_HPP
+#define SIMINUSMINUS_UTILS_THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cmm {
+namespace utils {
+
+/**
+ * \ingroup utils
+ * \brief Small work-stealing thread pool.
+ *
+ * Each worker thread owns a task queue. Workers take tasks from the back of their own
+ * queue and, when it is empty, steal tasks from the front of the queues of the others.
+ * For example:
+ *
+ * ``` cpp
+ * cmm::utils::ThreadPool pool(4);
+ * std::vector<int> squares(100);
+ *
+ * pool.parallelFor(squares.size(), [&](std::size_t i)
+ * {
+ *     squares[i] = i * i;
+ * });
+ * ```
+ */
+class ThreadPool
+{
+public:
+
+    /**
+     * Creates a pool with the given number of worker threads.
+     * @param threads: number of workers. By default, one per hardware thread.
+     */
+    explicit ThreadPool(std::size_t threads = defaultThreadCount());
+
+    /**
+     * Runs the pending tasks and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queues a task. Tasks submitted from a worker go to the queue of that worker.
+     * @param task: function to run on a worker thread.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Calls body(i) for each i in [0, count) and waits until all the calls finish.
+     * The calling thread takes part in the work, so parallelFor can be called from
+     * inside a task.
+     * @param count: number of iterations.
+     * @param body: function called for each iteration.
+     */
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+    /**
+     * Returns the number of worker threads.
+     */
+    std::size_t size() const;
+
+    /**
+     * Returns the number of hardware threads, at least one.
+     */
+    static std::size_t defaultThreadCount();
+
+private:
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /**
+     * Main loop of the worker threads.
+     * @param index: index of the worker.
+     */
+    void work(std::size_t index);
+
+    /**
+     * Takes a task, from the queue of the given worker first and from the other queues after.
+     * Returns false if all the queues are empty.
+     * @param index: index of the worker looking for work.
+     * @param task: where the task is stored.
+     */
+    bool take(std::size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> _queues; // One queue per worker
+    std::vector<std::thread> _threads;           // Worker threads
+    std::atomic<std::size_t> _pending;           // Tasks queued and not taken yet
+    std::atomic<std::size_t> _nextQueue;         // Round-robin queue for external submits
+    std::mutex _sleepMutex;                      // Guards the sleep of idle workers
+    std::condition_variable _wakeUp;             // Signals new tasks or stop
+    bool _stopping;                              // Set when the pool is being destroyed
+
+}; // class ThreadPool
+
+} // namespace utils
+} // namespace cmm
+
+#endif // SIMINUSMINUS_UTILS_THREADPOOL_HPP
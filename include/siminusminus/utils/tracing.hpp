@@ -0,0 +1,173 @@
+#ifndef SIMINUSMINUS_UTILS_TRACING_HPP
+#define SIMINUSMINUS_UTILS_TRACING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace cmm {
+namespace utils {
+
+/**
+ * \ingroup utils
+ * \brief Records timed spans and counters, and exports them as a Chrome trace.
+ *
+ * Each thread records its events into its own fixed size buffer, without locks, so
+ * tracing a hot path costs a couple of clock reads. The events are exported in the
+ * Chrome trace event format, which chrome://tracing and Perfetto can open. For example:
+ *
+ * ``` cpp
+ * cmm::utils::Tracer::start();
+ *
+ * {
+ *     SIMINUSMINUS_TRACE_SCOPE("parse");
+ *     parse(input);
+ *     SIMINUSMINUS_TRACE_COUNTER("records", records.size());
+ * }
+ *
+ * cmm::utils::Tracer::stop();
+ * cmm::utils::Tracer::exportChromeTrace(file);
+ * ```
+ *
+ * The SIMINUSMINUS_TRACE_* macros only record events when SIMINUSMINUS_TRACING is
+ * defined (see the SIMINUSMINUS_TRACING CMake option). Otherwise they expand to nothing
+ * and their arguments are not evaluated.
+ *
+ * Event names are not copied: they must be string literals, or live until the trace
+ * is exported.
+ *
+ * The buffers of finished threads are reused by new ones, so short lived threads do not
+ * keep allocating buffers. A thread taking over a buffer shares its thread id in the
+ * trace and its EventsPerThread limit with the threads that used it before.
+ */
+class Tracer
+{
+public:
+
+    /**
+     * Events each thread can record per trace. Later events are dropped.
+     */
+    static const std::size_t EventsPerThread = 1 << 16;
+
+    /**
+     * Discards the recorded events and starts recording. It must not be called while
+     * a trace is being exported.
+     */
+    static void start();
+
+    /**
+     * Stops recording. The recorded events are kept until the next start().
+     */
+    static void stop();
+
+    /**
+     * Returns true while recording.
+     */
+    static bool enabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the time of the monotonic clock used to timestamp events, in nanoseconds.
+     */
+    static std::uint64_t now()
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+     * Records a span of the current thread, if recording.
+     * @param name: name of the span.
+     * @param begin: now() when the span began.
+     * @param end: now() when the span ended.
+     */
+    static void span(const char* name, std::uint64_t begin, std::uint64_t end);
+
+    /**
+     * Records the value of a counter at this time, if recording.
+     * @param name: name of the counter.
+     * @param value: value of the counter.
+     */
+    static void counter(const char* name, std::int64_t value);
+
+    /**
+     * Writes the events of the last trace in Chrome trace event JSON format. Returns
+     * the number of events written.
+     * @param os: stream the trace is written to.
+     */
+    static std::size_t exportChromeTrace(std::ostream& os);
+
+    /**
+     * Returns the number of events of the last trace dropped because a thread buffer
+     * was full.
+     */
+    static std::size_t droppedEvents();
+
+private:
+
+    static std::atomic<bool> _enabled; // True while recording
+
+}; // class Tracer
+
+/**
+ * \ingroup utils
+ * \brief Records a span from its construction to its destruction.
+ *
+ * Nothing is recorded if the Tracer was not recording when the scope was created.
+ * Use it through SIMINUSMINUS_TRACE_SCOPE(name) to compile it out of builds without
+ * tracing.
+ */
+class TraceScope
+{
+public:
+
+    /**
+     * Starts the span.
+     * @param name: name of the span.
+     */
+    explicit TraceScope(const char* name):
+        _name(Tracer::enabled() ? name : nullptr),
+        _begin(_name != nullptr ? Tracer::now() : 0)
+    {
+    }
+
+    /**
+     * Ends and records the span.
+     */
+    ~TraceScope()
+    {
+        if (_name != nullptr)
+            Tracer::span(_name, _begin, Tracer::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+
+    const char* _name;    // Name of the span, null if not recorded
+    std::uint64_t _begin; // Time when the span began
+
+}; // class TraceScope
+
+} // namespace utils
+} // namespace cmm
+
+#define SIMINUSMINUS_TRACE_CONCATENATE_IMPL(lhs, rhs) lhs##rhs
+#define SIMINUSMINUS_TRACE_CONCATENATE(lhs, rhs) SIMINUSMINUS_TRACE_CONCATENATE_IMPL(lhs, rhs)
+
+#ifdef SIMINUSMINUS_TRACING
+    #define SIMINUSMINUS_TRACE_SCOPE(name) \
+        ::cmm::utils::TraceScope SIMINUSMINUS_TRACE_CONCATENATE(siminusminusTraceScope, __LINE__)(name)
+    #define SIMINUSMINUS_TRACE_COUNTER(name, value) \
+        ::cmm::utils::Tracer::counter(name, static_cast<std::int64_t>(value))
+#else
+    #define SIMINUSMINUS_TRACE_SCOPE(name) static_cast<void>(0)
+    #define SIMINUSMINUS_TRACE_COUNTER(name, value) static_cast<void>(0)
+#endif
+
+#endif // SIMINUSMINUS_UTILS_TRACING_HPP
@@ -0,0 +1,352 @@
+#include <siminusminus/containers/ahocorasick.hpp>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SIMINUSMINUS_AHOCORASICK_SSE2
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace cmm {
+namespace containers {
+
+namespace {
+
+/**
+ * Rough rank of how common a byte is in text, markup and source code, higher for the
+ * more common ones. The prefilter looks for the bytes with the lowest rank.
+ */
+unsigned int byteFrequency(unsigned char byte)
+{
+    static const char letters[] = "etaoinshrdlcumwfgypbvkjxqz"; // Most common first
+
+    if (byte >= 'a' && byte <= 'z')
+        return 230 - static_cast<unsigned int>(std::strchr(letters, byte) - letters);
+
+    if (byte >= 'A' && byte <= 'Z')
+        return 150 - static_cast<unsigned int>(std::strchr(letters, byte - 'A' + 'a') - letters);
+
+    if (byte == ' ')
+        return 255;
+
+    if (byte >= '0' && byte <= '9')
+        return 180;
+
+    if (byte == '\n' || (byte != '\0' && std::strchr(".,/-_:=\"'()<>", byte) != nullptr))
+        return 170;
+
+    if (byte == '\t' || byte == '\r' || byte == '\0')
+        return 120;
+
+    if (byte >= 0x80)
+        return 60;
+
+    return byte < 0x20 || byte == 0x7F ? 10 : 100;
+}
+
+/**
+ * Sum of the ranks of a set of bytes.
+ */
+unsigned int frequencyOf(const std::vector<unsigned char>& bytes)
+{
+    unsigned int total = 0;
+
+    for (unsigned char byte : bytes)
+        total += byteFrequency(byte);
+
+    return total;
+}
+
+} // namespace
+
+//////////////////////
+// AhoCorasickMatcher
+//////////////////////
+
+const std::uint32_t AhoCorasickMatcher::MatchFlag;
+const std::uint32_t AhoCorasickMatcher::NoLink;
+
+AhoCorasickMatcher::AhoCorasickMatcher(const std::vector<InmutableString>& patterns):
+    _classCount(1),
+    _prefilterSize(0)
+{
+    // Input classes: one per byte used by the patterns, class 0 for the rest
+    std::array<bool, 256> used;
+    used.fill(false);
+
+    for (const InmutableString& pattern : patterns)
+        for (std::size_t i = 0; i < pattern.length(); ++i)
+            used[static_cast<unsigned char>(pattern[i])] = true;
+
+    for (std::size_t byte = 0; byte < 256; ++byte)
+        _classes[byte] = used[byte] ? static_cast<std::uint16_t>(_classCount++) : 0;
+
+    // Trie. Missing children are NoLink until the BFS below fills them
+    std::vector<std::uint32_t> next(_classCount, NoLink);
+    std::vector<std::vector<std::uint32_t>> ownOutputs(1);
+
+    for (std::size_t id = 0; id < patterns.size(); ++id)
+    {
+        const InmutableString& pattern = patterns[id];
+        _patternLengths.push_back(pattern.length());
+
+        if (pattern.length() == 0)
+            continue;
+
+        std::uint32_t state = 0;
+
+        for (std::size_t i = 0; i < pattern.length(); ++i)
+        {
+            std::uint32_t& child = next[state * _classCount + _classes[static_cast<unsigned char>(pattern[i])]];
+
+            if (child == NoLink)
+            {
+                // Premultiplied states must stay below MatchFlag
+                if ((ownOutputs.size() + 1) * _classCount > MatchFlag)
+                    throw std::length_error("AhoCorasickMatcher: too many states for the transition table");
+
+                child = static_cast<std::uint32_t>(ownOutputs.size());
+                ownOutputs.emplace_back();
+                next.resize(next.size() + _classCount, NoLink);
+            }
+
+            state = next[state * _classCount + _classes[static_cast<unsigned char>(pattern[i])]];
+        }
+
+        ownOutputs[state].push_back(static_cast<std::uint32_t>(id));
+    }
+
+    const std::size_t states = ownOutputs.size();
+
+    // Failure links, folded into the transition table in BFS order so each state
+    // copies the already complete row of its failure state
+    std::vector<std::uint32_t> failure(states, 0);
+    std::deque<std::uint32_t> pending;
+    _outputLinks.assign(states, NoLink);
+
+    for (std::uint32_t c = 0; c < _classCount; ++c)
+    {
+        std::uint32_t& child = next[c];
+
+        if (child == NoLink)
+            child = 0;
+        else
+            pending.push_back(child);
+    }
+
+    while (!pending.empty())
+    {
+        const std::uint32_t state = pending.front();
+        pending.pop_front();
+
+        for (std::uint32_t c = 0; c < _classCount; ++c)
+        {
+            std::uint32_t& child = next[state * _classCount + c];
+            const std::uint32_t fallback = next[failure[state] * _classCount + c];
+
+            if (child == NoLink)
+            {
+                child = fallback;
+            }
+            else
+            {
+                failure[child] = fallback;
+                _outputLinks[child] = ownOutputs[fallback].empty() ? _outputLinks[fallback] : fallback;
+                pending.push_back(child);
+            }
+        }
+    }
+
+    // Flatten the outputs and premultiply the transitions
+    _outputBegin.reserve(states + 1);
+
+    for (std::size_t state = 0; state < states; ++state)
+    {
+        _outputBegin.push_back(static_cast<std::uint32_t>(_outputs.size()));
+        _outputs.insert(_outputs.end(), ownOutputs[state].begin(), ownOutputs[state].end());
+    }
+
+    _outputBegin.push_back(static_cast<std::uint32_t>(_outputs.size()));
+    _transitions.resize(next.size());
+
+    for (std::size_t i = 0; i < next.size(); ++i)
+    {
+        const std::uint32_t target = next[i];
+        const bool matches = !ownOutputs[target].empty() || _outputLinks[target] != NoLink;
+
+        _transitions[i] = target * _classCount | (matches ? MatchFlag : 0);
+    }
+
+    // Prefilter on up to three bytes such that every pattern contains one of them: the
+    // bytes starting the patterns if there are few, or the rarest byte of each pattern
+    std::vector<unsigned char> starts;
+    std::vector<unsigned char> rare;
+
+    for (const InmutableString& pattern : patterns)
+    {
+        if (pattern.length() == 0)
+            continue;
+
+        const unsigned char* const bytes = reinterpret_cast<const unsigned char*>(pattern.view().data());
+        const unsigned char* const last = bytes + pattern.length();
+
+        if (std::find(starts.begin(), starts.end(), bytes[0]) == starts.end())
+            starts.push_back(bytes[0]);
+
+        if (rare.size() <= _prefilter.size() && std::find_first_of(bytes, last, rare.begin(), rare.end()) == last)
+        {
+            rare.push_back(*std::min_element(bytes, last, [](unsigned char lhs, unsigned char rhs)
+            {
+                return byteFrequency(lhs) < byteFrequency(rhs);
+            }));
+        }
+    }
+
+    const bool startsFit = starts.size() <= _prefilter.size();
+    const bool rareFit = rare.size() <= _prefilter.size();
+    const std::vector<unsigned char>& chosen = startsFit && (!rareFit || frequencyOf(starts) <= frequencyOf(rare)) ?
+                                               starts : rare;
+
+    _prefilter.fill(0);
+    _prefilterOffsets.fill(0);
+
+    if (chosen.size() <= _prefilter.size())
+    {
+        std::copy(chosen.begin(), chosen.end(), _prefilter.begin());
+        _prefilterSize = chosen.size();
+    }
+
+    // A match whose first prefilter byte is found at position i starts at most that
+    // many bytes before i
+    for (const InmutableString& pattern : patterns)
+    {
+        const unsigned char* const bytes = reinterpret_cast<const unsigned char*>(pattern.view().data());
+        const unsigned char* const last = bytes + pattern.length();
+        const unsigned char* const first = std::find_first_of(bytes, last, _prefilter.begin(), _prefilter.begin() + _prefilterSize);
+
+        if (first != last)
+        {
+            std::size_t& offset = _prefilterOffsets[std::find(_prefilter.begin(), _prefilter.end(), *first) - _prefilter.begin()];
+            offset = std::max(offset, static_cast<std::size_t>(first - bytes));
+        }
+    }
+}
+
+std::size_t AhoCorasickMatcher::findAll(const ConstContiguousView<char>& text, std::vector<AhoCorasickMatch>& matches) const
+{
+    const std::size_t before = matches.size();
+
+    scan(text, [&matches](const AhoCorasickMatch& match)
+    {
+        matches.push_back(match);
+    });
+
+    return matches.size() - before;
+}
+
+bool AhoCorasickMatcher::containsAny(const ConstContiguousView<char>& text) const
+{
+    const unsigned char* it = reinterpret_cast<const unsigned char*>(text.data());
+    const unsigned char* const end = it + text.size();
+    const unsigned char* candidate = nullptr;
+    std::uint32_t state = 0;
+
+    while (it != end)
+    {
+        if (state == 0 && _prefilterSize != 0)
+        {
+            it = skipToCandidate(it, end, candidate);
+
+            if (it == end)
+                return false;
+        }
+
+        state = _transitions[state + _classes[*it]];
+        ++it;
+
+        if (state & MatchFlag)
+            return true;
+    }
+
+    return false;
+}
+
+std::size_t AhoCorasickMatcher::patternCount() const
+{
+    return _patternLengths.size();
+}
+
+std::size_t AhoCorasickMatcher::stateCount() const
+{
+    return _outputLinks.size();
+}
+
+const unsigned char* AhoCorasickMatcher::skipToCandidate(const unsigned char* from, const unsigned char* end,
+                                                         const unsigned char*& candidate) const
+{
+    // A candidate still ahead is the first prefilter byte from here too
+    if (candidate == nullptr || candidate < from)
+        candidate = findPrefilterByte(from, end);
+
+    if (candidate == end)
+        return end;
+
+    const std::size_t slot = static_cast<std::size_t>(std::find(_prefilter.begin(), _prefilter.end(), *candidate) - _prefilter.begin());
+    const std::size_t back = _prefilterOffsets[slot];
+
+    return static_cast<std::size_t>(candidate - from) > back ? candidate - back : from;
+}
+
+const unsigned char* AhoCorasickMatcher::findPrefilterByte(const unsigned char* from, const unsigned char* end) const
+{
+#ifdef SIMINUSMINUS_AHOCORASICK_SSE2
+    // Unused prefilter slots repeat the first byte, so three comparisons always work
+    const __m128i first = _mm_set1_epi8(static_cast<char>(_prefilter[0]));
+    const __m128i second = _mm_set1_epi8(static_cast<char>(_prefilter[_prefilterSize > 1 ? 1 : 0]));
+    const __m128i third = _mm_set1_epi8(static_cast<char>(_prefilter[_prefilterSize > 2 ? 2 : 0]));
+
+    while (end - from >= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+        const __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, first),
+                                                       _mm_cmpeq_epi8(block, second)),
+                                          _mm_cmpeq_epi8(block, third));
+        const int mask = _mm_movemask_epi8(hits);
+
+        if (mask != 0)
+        {
+        #if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward(&index, static_cast<unsigned long>(mask));
+            return from + index;
+        #else
+            return from + __builtin_ctz(static_cast<unsigned int>(mask));
+        #endif
+        }
+
+        from += 16;
+    }
+#endif
+
+    if (_prefilterSize == 1)
+    {
+        const void* hit = std::memchr(from, _prefilter[0], static_cast<std::size_t>(end - from));
+        return hit != nullptr ? static_cast<const unsigned char*>(hit) : end;
+    }
+
+    for (; from != end; ++from)
+        for (std::size_t i = 0; i < _prefilterSize; ++i)
+            if (*from == _prefilter[i])
+                return from;
+
+    return end;
+}
+
+} // namespace containers
+} // namespace cmm
@@ -0,0 +1,340 @@
+#include <siminusminus/containers/editdistance.hpp>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SIMINUSMINUS_EDITDISTANCE_SSE2
+#endif
+
+namespace cmm {
+namespace containers {
+
+namespace {
+
+const std::size_t WordBits = 64;
+
+/**
+ * Value returned when the distance is greater than the threshold k.
+ */
+std::size_t beyond(std::size_t k)
+{
+    return k == FuzzyMatcher::Unbounded ? k : k + 1;
+}
+
+/**
+ * Returns true if a score can not go down to k with the remaining text characters,
+ * each of which changes the score by one at most.
+ */
+bool outOfReach(std::size_t score, std::size_t remaining, std::size_t k)
+{
+    return score > remaining && score - remaining > k;
+}
+
+/**
+ * Returns true if the difference of the lengths alone is greater than k.
+ */
+bool lengthsTooFar(std::size_t lhs, std::size_t rhs, std::size_t k)
+{
+    return (lhs > rhs ? lhs - rhs : rhs - lhs) > k;
+}
+
+/**
+ * Advances one word of a column of the Myers/Hyyrö algorithm. hin is the horizontal
+ * delta entering the word from above (-1, 0 or +1) and the function returns the one
+ * leaving it through the bit high.
+ */
+int advanceWord(std::uint64_t& pv, std::uint64_t& mv, std::uint64_t eq, int hin, std::uint64_t high)
+{
+    const std::uint64_t xv = eq | mv;
+
+    if (hin < 0)
+        eq |= 1;
+
+    const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    std::uint64_t ph = mv | ~(xh | pv);
+    std::uint64_t mh = pv & xh;
+    const int hout = (ph & high) ? 1 : ((mh & high) ? -1 : 0);
+
+    ph <<= 1;
+    mh <<= 1;
+
+    if (hin < 0)
+        mh |= 1;
+    else if (hin > 0)
+        ph |= 1;
+
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+
+    return hout;
+}
+
+/**
+ * Myers/Hyyrö distance for a query of 1 to 64 characters, whose match masks (one word
+ * per byte) are given.
+ */
+std::size_t singleWordDistance(const std::uint64_t* masks, std::size_t queryLength,
+                               const unsigned char* text, std::size_t length, std::size_t k)
+{
+    const std::uint64_t high = std::uint64_t(1) << (queryLength - 1);
+    std::uint64_t pv = ~std::uint64_t(0);
+    std::uint64_t mv = 0;
+    std::size_t score = queryLength;
+
+    for (std::size_t j = 0; j < length; ++j)
+    {
+        const std::uint64_t eq = masks[text[j]];
+        const std::uint64_t xv = eq | mv;
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+
+        score += (ph & high) != 0;
+        score -= (mh & high) != 0;
+
+        // The first row of a global alignment always grows by one
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        if (outOfReach(score, length - j - 1, k))
+            return beyond(k);
+    }
+
+    return score <= k ? score : beyond(k);
+}
+
+} // namespace
+
+////////////////
+// FuzzyMatcher
+////////////////
+
+const std::size_t FuzzyMatcher::Unbounded;
+
+FuzzyMatcher::FuzzyMatcher(const ConstContiguousView<char>& query):
+    _length(query.size()),
+    _words((query.size() + WordBits - 1) / WordBits),
+    _masks(256 * std::max<std::size_t>(_words, 1), 0)
+{
+    const unsigned char* characters = reinterpret_cast<const unsigned char*>(query.data());
+
+    for (std::size_t i = 0; i < _length; ++i)
+        _masks[characters[i] * _words + i / WordBits] |= std::uint64_t(1) << (i % WordBits);
+}
+
+std::size_t FuzzyMatcher::distance(const ConstContiguousView<char>& candidate) const
+{
+    return distance(candidate, Unbounded);
+}
+
+std::size_t FuzzyMatcher::distance(const ConstContiguousView<char>& candidate, std::size_t k) const
+{
+    const unsigned char* text = reinterpret_cast<const unsigned char*>(candidate.data());
+
+    if (lengthsTooFar(_length, candidate.size(), k))
+        return beyond(k);
+
+    if (_length == 0)
+        return candidate.size();
+
+    if (_words == 1)
+        return distanceSingleWord(text, candidate.size(), k);
+
+    return distanceMultiWord(text, candidate.size(), k);
+}
+
+std::size_t FuzzyMatcher::findWithin(const std::vector<InmutableString>& candidates, std::size_t k, std::vector<FuzzyMatch>& matches) const
+{
+    std::vector<std::size_t> distances(candidates.size(), beyond(k));
+    std::vector<std::size_t> pending; // Candidates not discarded by their length
+
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+        if (!lengthsTooFar(_length, candidates[i].length(), k))
+            pending.push_back(i);
+
+    std::size_t next = 0;
+
+#ifdef SIMINUSMINUS_EDITDISTANCE_SSE2
+    if (_words == 1)
+    {
+        for (; next + 1 < pending.size(); next += 2)
+        {
+            std::size_t pair[2];
+            distancePair(candidates[pending[next]].view(), candidates[pending[next + 1]].view(), k, pair);
+
+            distances[pending[next]] = pair[0];
+            distances[pending[next + 1]] = pair[1];
+        }
+    }
+#endif
+
+    for (; next < pending.size(); ++next)
+        distances[pending[next]] = distance(candidates[pending[next]].view(), k);
+
+    const std::size_t before = matches.size();
+
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+        if (distances[i] <= k)
+            matches.push_back(FuzzyMatch{i, distances[i]});
+
+    return matches.size() - before;
+}
+
+std::size_t FuzzyMatcher::queryLength() const
+{
+    return _length;
+}
+
+std::size_t FuzzyMatcher::distanceSingleWord(const unsigned char* text, std::size_t length, std::size_t k) const
+{
+    return singleWordDistance(_masks.data(), _length, text, length, k);
+}
+
+std::size_t FuzzyMatcher::distanceMultiWord(const unsigned char* text, std::size_t length, std::size_t k) const
+{
+    const std::uint64_t lastHigh = std::uint64_t(1) << ((_length - 1) % WordBits);
+    const std::uint64_t high = std::uint64_t(1) << (WordBits - 1);
+    std::vector<std::uint64_t> pv(_words, ~std::uint64_t(0));
+    std::vector<std::uint64_t> mv(_words, 0);
+    std::size_t score = _length;
+
+    for (std::size_t j = 0; j < length; ++j)
+    {
+        const std::uint64_t* eq = &_masks[text[j] * _words];
+        int h = 1; // The first row of a global alignment always grows by one
+
+        for (std::size_t w = 0; w < _words; ++w)
+            h = advanceWord(pv[w], mv[w], eq[w], h, w + 1 == _words ? lastHigh : high);
+
+        if (h > 0)
+            ++score;
+        else if (h < 0)
+            --score;
+
+        if (outOfReach(score, length - j - 1, k))
+            return beyond(k);
+    }
+
+    return score <= k ? score : beyond(k);
+}
+
+void FuzzyMatcher::distancePair(const ConstContiguousView<char>& first, const ConstContiguousView<char>& second,
+                                std::size_t k, std::size_t distances[2]) const
+{
+#ifdef SIMINUSMINUS_EDITDISTANCE_SSE2
+    const unsigned char* texts[2] = {reinterpret_cast<const unsigned char*>(first.data()),
+                                     reinterpret_cast<const unsigned char*>(second.data())};
+    const std::size_t lengths[2] = {first.size(), second.size()};
+    bool done[2] = {false, false};
+
+    // Empty query or candidates have trivial distances
+    for (std::size_t lane = 0; lane < 2; ++lane)
+    {
+        if (_length == 0 || lengths[lane] == 0)
+        {
+            const std::size_t trivial = _length + lengths[lane];
+            distances[lane] = trivial <= k ? trivial : beyond(k);
+            done[lane] = true;
+        }
+    }
+
+    const __m128i one = _mm_set_epi32(0, 1, 0, 1);
+    const __m128i allOnes = _mm_set1_epi32(-1);
+    const __m128i highShift = _mm_cvtsi32_si128(static_cast<int>(_length - 1));
+    __m128i pv = allOnes;
+    __m128i mv = _mm_setzero_si128();
+    __m128i score = _mm_set_epi64x(static_cast<long long>(_length), static_cast<long long>(_length));
+    const std::size_t longest = std::max(lengths[0], lengths[1]);
+
+    for (std::size_t j = 0; j < longest && !(done[0] && done[1]); ++j)
+    {
+        // Lanes past the end of their candidate keep running on a no-match column
+        const std::uint64_t eq0 = j < lengths[0] ? _masks[texts[0][j]] : 0;
+        const std::uint64_t eq1 = j < lengths[1] ? _masks[texts[1][j]] : 0;
+        const __m128i eq = _mm_set_epi64x(static_cast<long long>(eq1), static_cast<long long>(eq0));
+
+        const __m128i xv = _mm_or_si128(eq, mv);
+        const __m128i sum = _mm_add_epi64(_mm_and_si128(eq, pv), pv);
+        const __m128i xh = _mm_or_si128(_mm_xor_si128(sum, pv), eq);
+        __m128i ph = _mm_or_si128(mv, _mm_xor_si128(_mm_or_si128(xh, pv), allOnes));
+        __m128i mh = _mm_and_si128(pv, xh);
+
+        score = _mm_add_epi64(score, _mm_and_si128(_mm_srl_epi64(ph, highShift), one));
+        score = _mm_sub_epi64(score, _mm_and_si128(_mm_srl_epi64(mh, highShift), one));
+
+        ph = _mm_or_si128(_mm_slli_epi64(ph, 1), one);
+        mh = _mm_slli_epi64(mh, 1);
+        pv = _mm_or_si128(mh, _mm_xor_si128(_mm_or_si128(xv, ph), allOnes));
+        mv = _mm_and_si128(ph, xv);
+
+        const bool laneEnds = j + 1 == lengths[0] || j + 1 == lengths[1];
+
+        if (laneEnds || j % 8 == 7) // Reading the scores back is not free, so bounds are checked every few columns
+        {
+            std::uint64_t scores[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(scores), score);
+
+            for (std::size_t lane = 0; lane < 2; ++lane)
+            {
+                if (done[lane])
+                    continue;
+
+                const std::size_t laneScore = static_cast<std::size_t>(scores[lane]);
+
+                if (j + 1 == lengths[lane])
+                {
+                    distances[lane] = laneScore <= k ? laneScore : beyond(k);
+                    done[lane] = true;
+                }
+                else if (outOfReach(laneScore, lengths[lane] - j - 1, k))
+                {
+                    distances[lane] = beyond(k);
+                    done[lane] = true;
+                }
+            }
+        }
+    }
+#else
+    distances[0] = distance(first, k);
+    distances[1] = distance(second, k);
+#endif
+}
+
+///////////////////////////
+// Edit distance functions
+///////////////////////////
+
+std::size_t editDistance(const ConstContiguousView<char>& lhs, const ConstContiguousView<char>& rhs)
+{
+    return boundedEditDistance(lhs, rhs, FuzzyMatcher::Unbounded);
+}
+
+std::size_t boundedEditDistance(const ConstContiguousView<char>& lhs, const ConstContiguousView<char>& rhs, std::size_t k)
+{
+    // The shorter string is the query, so the columns have fewer words
+    const ConstContiguousView<char>& query = lhs.size() < rhs.size() ? lhs : rhs;
+    const ConstContiguousView<char>& text = lhs.size() < rhs.size() ? rhs : lhs;
+
+    if (lengthsTooFar(query.size(), text.size(), k))
+        return beyond(k);
+
+    if (query.size() == 0)
+        return text.size();
+
+    if (query.size() > WordBits)
+        return FuzzyMatcher(query).distance(text, k);
+
+    // Queries of one word keep their masks on the stack instead of building a FuzzyMatcher
+    const unsigned char* characters = reinterpret_cast<const unsigned char*>(query.data());
+    std::uint64_t masks[256] = {};
+
+    for (std::size_t i = 0; i < query.size(); ++i)
+        masks[characters[i]] |= std::uint64_t(1) << i;
+
+    return singleWordDistance(masks, query.size(), reinterpret_cast<const unsigned char*>(text.data()), text.size(), k);
+}
+
+} // namespace containers
+} // namespace cmm
@@ -0,0 +1,475 @@
+#include <siminusminus/containers/globmatcher.hpp>
+#include <algorithm>
+#include <bitset>
+#include <map>
+
+namespace cmm {
+namespace containers {
+
+namespace {
+
+/**
+ * One element of a parsed pattern: either a `*` or a set of accepted bytes.
+ */
+struct GlobItem
+{
+    bool star;               // True for `*`
+    std::bitset<256> bytes;  // Accepted bytes, if not a star
+};
+
+/**
+ * Parses a bracket expression starting right after the `[`. Returns false if the
+ * expression is not closed, in which case the `[` is taken as a literal and bytes is
+ * left unchanged.
+ */
+bool parseClass(const unsigned char* pattern, std::size_t length, std::size_t& i, std::bitset<256>& bytes)
+{
+    std::size_t j = i;
+    bool negated = false;
+    std::bitset<256> accepted;
+
+    if (j < length && (pattern[j] == '!' || pattern[j] == '^'))
+    {
+        negated = true;
+        ++j;
+    }
+
+    for (bool first = true; j < length && (first || pattern[j] != ']'); first = false)
+    {
+        unsigned char from = pattern[j++];
+
+        if (from == '\\' && j < length)
+            from = pattern[j++];
+
+        unsigned char to = from;
+
+        if (j + 1 < length && pattern[j] == '-' && pattern[j + 1] != ']')
+        {
+            to = pattern[j + 1];
+            j += 2;
+
+            if (to == '\\' && j < length)
+                to = pattern[j++];
+        }
+
+        for (unsigned int c = from; c <= to; ++c)
+            accepted.set(c);
+    }
+
+    if (j >= length)
+        return false;
+
+    if (negated)
+        accepted.flip();
+
+    bytes = accepted;
+    i = j + 1;
+    return true;
+}
+
+/**
+ * Splits a pattern into items. Runs of stars are collapsed into one.
+ */
+std::vector<GlobItem> parsePattern(const InmutableString& pattern)
+{
+    const unsigned char* characters = reinterpret_cast<const unsigned char*>(pattern.data());
+    const std::size_t length = pattern.length();
+    std::vector<GlobItem> items;
+
+    for (std::size_t i = 0; i < length;)
+    {
+        GlobItem item{false, {}};
+        const unsigned char c = characters[i++];
+
+        if (c == '*')
+        {
+            if (!items.empty() && items.back().star)
+                continue;
+
+            item.star = true;
+        }
+        else if (c == '?')
+            item.bytes.set();
+        else if (c == '\\' && i < length)
+            item.bytes.set(characters[i++]);
+        else if (c != '[' || !parseClass(characters, length, i, item.bytes))
+            item.bytes.set(c);
+
+        items.push_back(item);
+    }
+
+    return items;
+}
+
+/**
+ * Returns true if every item but the stars matches exactly one byte.
+ */
+bool isLiteral(const std::vector<GlobItem>& items)
+{
+    return std::all_of(items.begin(), items.end(), [](const GlobItem& item)
+    {
+        return item.star || item.bytes.count() == 1;
+    });
+}
+
+/**
+ * Returns the byte matched by a single byte item.
+ */
+unsigned char literalByte(const GlobItem& item)
+{
+    std::size_t c = 0;
+
+    while (!item.bytes.test(c))
+        ++c;
+
+    return static_cast<unsigned char>(c);
+}
+
+/**
+ * A literal pattern on its way into a trie.
+ */
+struct LiteralPattern
+{
+    std::vector<unsigned char> text; // Characters, reversed for suffixes
+    std::uint32_t pattern;           // Id of the pattern
+    bool exact;                      // True for the whole text, false for an open end
+};
+
+/**
+ * Builds a trie from literal patterns.
+ */
+detail::GlobLiteralTrie buildTrie(const std::vector<LiteralPattern>& literals)
+{
+    detail::GlobLiteralTrie trie;
+
+    if (literals.empty())
+        return trie;
+
+    // Children of each node by byte, and patterns ending at each node
+    std::vector<std::map<unsigned char, std::uint32_t>> nodes(1);
+    std::vector<std::vector<std::uint32_t>> open(1);
+    std::vector<std::vector<std::uint32_t>> exact(1);
+
+    for (const LiteralPattern& literal : literals)
+    {
+        std::uint32_t node = 0;
+
+        for (unsigned char c : literal.text)
+        {
+            const auto inserted = nodes[node].insert(std::make_pair(c, static_cast<std::uint32_t>(nodes.size())));
+
+            if (inserted.second)
+            {
+                nodes.emplace_back();
+                open.emplace_back();
+                exact.emplace_back();
+            }
+
+            node = inserted.first->second;
+        }
+
+        (literal.exact ? exact : open)[node].push_back(literal.pattern);
+    }
+
+    for (std::size_t node = 0; node < nodes.size(); ++node)
+    {
+        trie.edgeBegin.push_back(static_cast<std::uint32_t>(trie.labels.size()));
+
+        for (const auto& edge : nodes[node])
+        {
+            trie.labels.push_back(edge.first);
+            trie.children.push_back(edge.second);
+        }
+
+        trie.outputBegin.push_back(static_cast<std::uint32_t>(trie.outputs.size()));
+        trie.outputs.insert(trie.outputs.end(), open[node].begin(), open[node].end());
+        trie.outputBegin.push_back(static_cast<std::uint32_t>(trie.outputs.size()));
+        trie.outputs.insert(trie.outputs.end(), exact[node].begin(), exact[node].end());
+    }
+
+    trie.edgeBegin.push_back(static_cast<std::uint32_t>(trie.labels.size()));
+    trie.outputBegin.push_back(static_cast<std::uint32_t>(trie.outputs.size()));
+
+    return trie;
+}
+
+/**
+ * Adds a position to a set, with the ones after the stars following it.
+ */
+void close(const std::vector<detail::GlobPosition>& positions, std::uint32_t position, std::vector<std::uint32_t>& set)
+{
+    set.push_back(position);
+
+    while (!positions[position].end && positions[position].star)
+        set.push_back(++position);
+}
+
+} // namespace
+
+///////////////
+// GlobMatcher
+///////////////
+
+const std::size_t GlobMatcher::MaxStates;
+
+GlobMatcher::GlobMatcher(const std::vector<InmutableString>& patterns):
+    _patterns(patterns.size()),
+    _classes(),
+    _classCount(1),
+    _start(0),
+    _builtLimit(1),
+    _transitions(1, 0),
+    _acceptBegin(2, 0)
+{
+    // Automaton positions, patterns one after the other. Position i of a pattern is
+    // the point before its item i, the last one is the end of the pattern
+    std::vector<detail::GlobPosition> positions;
+    std::vector<std::uint32_t> starts; // First position of each compiled pattern
+    std::vector<LiteralPattern> prefixes;
+    std::vector<LiteralPattern> suffixes;
+
+    for (std::size_t id = 0; id < patterns.size(); ++id)
+    {
+        const std::vector<GlobItem> parsed = parsePattern(patterns[id]);
+        const std::size_t stars = std::count_if(parsed.begin(), parsed.end(), [](const GlobItem& item) { return item.star; });
+
+        if (isLiteral(parsed) && (stars == 0 || (stars == 1 && (parsed.front().star || parsed.back().star))))
+        {
+            LiteralPattern literal{{}, static_cast<std::uint32_t>(id), stars == 0};
+
+            for (const GlobItem& item : parsed)
+                if (!item.star)
+                    literal.text.push_back(literalByte(item));
+
+            if (stars == 0 || parsed.back().star)
+            {
+                prefixes.push_back(std::move(literal));
+            }
+            else
+            {
+                std::reverse(literal.text.begin(), literal.text.end());
+                suffixes.push_back(std::move(literal));
+            }
+
+            continue;
+        }
+
+        starts.push_back(static_cast<std::uint32_t>(positions.size()));
+
+        for (const GlobItem& item : parsed)
+            positions.push_back(detail::GlobPosition{item.bytes, item.star, false, static_cast<std::uint32_t>(id)});
+
+        positions.push_back(detail::GlobPosition{{}, false, true, static_cast<std::uint32_t>(id)});
+    }
+
+    _prefixes = buildTrie(prefixes);
+    _suffixes = buildTrie(suffixes);
+
+    if (starts.empty())
+        return;
+
+    // Bytes accepted by exactly the same items share an input class
+    for (const detail::GlobPosition& position : positions)
+    {
+        if (position.star)
+            continue;
+
+        std::map<std::pair<std::uint16_t, bool>, std::uint16_t> refined;
+
+        for (std::size_t c = 0; c < 256; ++c)
+            _classes[c] = refined.insert(std::make_pair(std::make_pair(_classes[c], position.bytes.test(c)),
+                                                        static_cast<std::uint16_t>(refined.size()))).first->second;
+    }
+
+    _classCount = 1 + *std::max_element(_classes.begin(), _classes.end());
+
+    std::vector<unsigned char> representatives(_classCount);
+
+    for (std::size_t c = 256; c-- > 0;)
+        representatives[_classes[c]] = static_cast<unsigned char>(c);
+
+    // Subset construction. State 0 is the dead (empty) state. Only the first MaxStates
+    // states are built, the others keep their positions
+    std::vector<std::vector<std::uint32_t>> states(1);
+    std::map<std::vector<std::uint32_t>, std::uint32_t> ids;
+    ids[states[0]] = 0;
+
+    const auto intern = [&](std::vector<std::uint32_t>& set)
+    {
+        std::sort(set.begin(), set.end());
+        set.erase(std::unique(set.begin(), set.end()), set.end());
+
+        const auto inserted = ids.insert(std::make_pair(set, static_cast<std::uint32_t>(states.size())));
+
+        if (inserted.second)
+            states.push_back(set);
+
+        return inserted.first->second;
+    };
+
+    std::vector<std::uint32_t> initial;
+
+    for (std::uint32_t start : starts)
+        close(positions, start, initial);
+
+    const std::uint32_t startState = intern(initial);
+    _transitions.clear();
+    _acceptBegin.assign(1, 0);
+
+    std::size_t built = 0;
+
+    for (; built < states.size() && built < MaxStates; ++built)
+    {
+        const std::vector<std::uint32_t> current = states[built];
+        _transitions.resize((built + 1) * _classCount, 0);
+
+        for (std::uint32_t input = 0; input < _classCount; ++input)
+        {
+            std::vector<std::uint32_t> next;
+
+            for (std::uint32_t position : current)
+            {
+                if (positions[position].end)
+                    continue;
+
+                if (positions[position].star)
+                    close(positions, position, next);
+                else if (positions[position].bytes.test(representatives[input]))
+                    close(positions, position + 1, next);
+            }
+
+            _transitions[built * _classCount + input] = intern(next);
+        }
+
+        for (std::uint32_t position : current)
+            if (positions[position].end)
+                _accepts.push_back(positions[position].pattern);
+
+        _acceptBegin.push_back(static_cast<std::uint32_t>(_accepts.size()));
+    }
+
+    // Premultiply the built states. The ones not built are numbered from _builtLimit
+    _builtLimit = static_cast<std::uint32_t>(built * _classCount);
+
+    for (std::uint32_t& next : _transitions)
+        next = next < built ? next * _classCount : _builtLimit + static_cast<std::uint32_t>(next - built);
+
+    if (built < states.size())
+    {
+        _pending.assign(states.begin() + static_cast<std::ptrdiff_t>(built), states.end());
+        _positions = std::move(positions);
+    }
+
+    _start = startState * _classCount;
+}
+
+bool GlobMatcher::matchesAny(const ConstContiguousView<char>& text) const
+{
+    bool found = false;
+    const auto setFound = [&found](std::size_t)
+    {
+        found = true;
+    };
+
+    _prefixes.walk(text, false, setFound);
+    _suffixes.walk(text, true, setFound);
+
+    if (found)
+        return true;
+
+    std::vector<std::uint32_t> simulated;
+    std::size_t count;
+    runAutomaton(text, simulated, count);
+
+    return count != 0;
+}
+
+std::size_t GlobMatcher::matchAll(const ConstContiguousView<char>& text, std::vector<std::size_t>& matches) const
+{
+    const std::size_t before = matches.size();
+
+    match(text, [&matches](std::size_t pattern)
+    {
+        matches.push_back(pattern);
+    });
+
+    std::sort(matches.begin() + before, matches.end());
+    return matches.size() - before;
+}
+
+std::size_t GlobMatcher::patternCount() const
+{
+    return _patterns;
+}
+
+std::size_t GlobMatcher::stateCount() const
+{
+    return _start == 0 ? 0 : _transitions.size() / _classCount;
+}
+
+const std::uint32_t* GlobMatcher::runAutomaton(const ConstContiguousView<char>& text, std::vector<std::uint32_t>& simulated,
+                                               std::size_t& count) const
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    const std::size_t length = text.size();
+    std::uint32_t state = _start;
+
+    for (std::size_t i = 0; i < length && state != 0; ++i)
+    {
+        state = _transitions[state + _classes[bytes[i]]];
+
+        if (state >= _builtLimit)
+            return simulate(_pending[state - _builtLimit], text, i + 1, simulated, count);
+    }
+
+    if (state == 0)
+    {
+        count = 0;
+        return nullptr;
+    }
+
+    state /= _classCount;
+    count = _acceptBegin[state + 1] - _acceptBegin[state];
+
+    return _accepts.data() + _acceptBegin[state];
+}
+
+const std::uint32_t* GlobMatcher::simulate(const std::vector<std::uint32_t>& positions, const ConstContiguousView<char>& text,
+                                           std::size_t from, std::vector<std::uint32_t>& simulated, std::size_t& count) const
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    std::vector<std::uint32_t> current(positions);
+    std::vector<std::uint32_t> next;
+
+    for (std::size_t i = from; i < text.size() && !current.empty(); ++i)
+    {
+        next.clear();
+
+        for (std::uint32_t position : current)
+        {
+            const detail::GlobPosition& item = _positions[position];
+
+            if (item.end)
+                continue;
+
+            if (item.star)
+                close(_positions, position, next);
+            else if (item.bytes.test(bytes[i]))
+                close(_positions, position + 1, next);
+        }
+
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        current.swap(next);
+    }
+
+    for (std::uint32_t position : current)
+        if (_positions[position].end)
+            simulated.push_back(_positions[position].pattern);
+
+    count = simulated.size();
+    return simulated.data();
+}
+
+} // namespace containers
+} // namespace cmm
@@ -1,177 +1,75 @@
 #include <siminusminus/containers/inmutablestring.hpp>
+#include <siminusminus/containers/numericconversions.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SIMINUSMINUS_INMUTABLESTRING_SSE2
+#endif
 
 using namespace cmm::utils;
 
 namespace cmm {
 namespace containers {
 
-///////////////////
-// InmutableString
-///////////////////
-
-InmutableString::InmutableString(): _string(nullptr), _length(0)
-{
-    createString(_length, "");
-    DebugUtilities::log(std::string("+++ InmutableString() called. void string created."));
-    stringLog();
-}
-
-InmutableString::InmutableString(const char* string): _string(nullptr), _length(0)
-{
-    createString(std::strlen(string), string);
-    DebugUtilities::log(std::string("+++ InmutableString(const char* string) called."));
-    stringLog();
-}
+namespace detail {
 
-InmutableString::InmutableString(const InmutableString& istring): InmutableString(istring._string)
+void shiftRange(const char* in, char* out, std::size_t length, const char first, const char delta)
 {
-    DebugUtilities::log(std::string("+++ InmutableString(const InmutableString& istring). Copy constructor."));
-}
+    std::size_t i = 0;
 
-InmutableString::InmutableString(InmutableString&& istring): _string(nullptr), _length(0)
-{
-    DebugUtilities::log(std::string("+++ InmutableString(const InmutableString&& istring). Move constructor."));
-    stealValues(istring); // points to the same string
-    istring.setDefault(); // erase the reference from istring
-}
+#ifdef SIMINUSMINUS_INMUTABLESTRING_SSE2
+    // Moving first to -128 turns the range check into a single signed comparison
+    const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80 - first));
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+    const __m128i shift = _mm_set1_epi8(delta);
 
-InmutableString::~InmutableString()
-{
-    if (_string != nullptr)
+    for (; i + 16 <= length; i += 16)
     {
-        DebugUtilities::log(std::string("--- ~InmutableString()."));
-        stringLog();
-
-        delete[] _string;
-        setDefault(); // To take precautions
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i inRange = _mm_cmplt_epi8(_mm_add_epi8(block, bias), limit);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_add_epi8(block, _mm_and_si128(inRange, shift)));
     }
-    else
-        DebugUtilities::log(std::string("--- ~InmutableString(). Nothing to delete, void string."));
-}
-
-const char& InmutableString::operator[](const size_t index) const
-{
-    return _string[index];
-}
-
-bool InmutableString::operator==(const InmutableString& rhs) const
-{
-    return std::strcmp(_string, rhs._string) == 0;
-}
-
-bool InmutableString::operator!=(const InmutableString& rhs) const
-{
-    return std::strcmp(_string, rhs._string) != 0;
-} 
-
-bool InmutableString::operator>(const InmutableString& rhs) const
-{
-    ConstContiguousView<char> thisViewer(&_string[0], &_string[_length + 2]);
-    ConstContiguousView<char> rhsViewer(&rhs._string[0], &rhs._string[rhs._length + 2]);
-
-    return !std::lexicographical_compare(thisViewer.begin(), thisViewer.end(),
-                                        rhsViewer.begin(), rhsViewer.end());
-}
-
-bool InmutableString::operator<(const InmutableString& rhs) const
-{
-    ConstContiguousView<char> thisViewer(&_string[0], &_string[_length + 2]);
-    ConstContiguousView<char> rhsViewer(&rhs._string[0], &rhs._string[rhs._length + 2]);
-
-    return std::lexicographical_compare(thisViewer.begin(), thisViewer.end(),
-                                        rhsViewer.begin(), rhsViewer.end());
-}
-
-bool InmutableString::operator>=(const InmutableString& rhs) const
-{
-    return *this == rhs || *this > rhs;
-}
+#endif
 
-bool InmutableString::operator<=(const InmutableString& rhs) const
-{
-    return *this == rhs || *this < rhs;
-}
-
-InmutableString& InmutableString::operator=(const InmutableString& rhs)
-{
-    DebugUtilities::log(std::string("*** InmutableString::operator=(const InmutableString& rhs)."));
-
-    if (this == &rhs) // Points to the same data
-        return *this; // Not doing the assignment
-
-    if (_string != nullptr) 
-        delete[] _string; // Erase data
-
-    setDefault(); // To take precautions
-
-    createString(rhs._length, rhs._string);
-
-    return *this; // Return the own object
-}
-
-InmutableString& InmutableString::operator=(InmutableString&& rhs)
-{
-    DebugUtilities::log(std::string("*** InmutableString::operator=(const InmutableString&& rhs)."));
-
-    stealValues(rhs);
-    rhs.setDefault();
-
-    return *this;
-}
-
-InmutableString operator+(InmutableString lhs, const InmutableString& rhs)
-{
-    DebugUtilities::log(std::string("*** operator+(InmutableString lhs, const InmutableString& rhs)."));
-    lhs.createString(lhs._length + rhs._length, strcat(lhs._string, rhs._string));
-    lhs.stringLog();
-
-    return lhs;
-}
-
-std::ostream& operator<<(std::ostream& os, const InmutableString& istring)
-{
-    os << istring._string;
-
-    return os;
+    for (; i < length; ++i)
+        out[i] = static_cast<char>(in[i] + ((in[i] >= first && in[i] <= first + 25) ? delta : 0));
 }
 
-std::string InmutableString::toString() const
+void replaceChar(const char* in, char* out, std::size_t length, const char from, const char to)
 {
-    return std::string(_string);
-}
+    std::size_t i = 0;
 
-void InmutableString::createString(const size_t newLength, const char* newString)
-{
-    size_t newSize = newLength+1; // Inlude '/0'
+#ifdef SIMINUSMINUS_INMUTABLESTRING_SSE2
+    const __m128i fromBlock = _mm_set1_epi8(from);
+    const __m128i toBlock = _mm_set1_epi8(to);
 
-    _string = new char[newSize]; // Get allocation memory for our string
-    _length = newLength;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i found = _mm_cmpeq_epi8(block, fromBlock);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_or_si128(_mm_and_si128(found, toBlock), _mm_andnot_si128(found, block)));
+    }
+#endif
 
-    std::strcpy(_string, newString); // Copy the string
+    for (; i < length; ++i)
+        out[i] = in[i] == from ? to : in[i];
 }
 
-void InmutableString::stringLog() const
-{
-    DebugUtilities::log("String: " + toString());
-    DebugUtilities::log("String length: " + std::to_string(_length) + "\n");
-}
+} // namespace detail
 
-void InmutableString::setDefault()
-{
-    _string = nullptr;
-    _length = 0;
-}
+////////////////
+// DebugLogging
+////////////////
 
-void InmutableString::stealValues( InmutableString& istring)
+void DebugLogging::logContents(const char* data, std::size_t length)
 {
-    _string = istring._string;
-    _length = istring._length;
-}
+    if (data != nullptr)
+        DebugUtilities::log("String: " + std::string(data, length));
 
-size_t InmutableString::length() const
-{
-    return _length;
+    char digits[NumericBufferSize::Integer];
+    DebugUtilities::log("String length: " + std::string(digits, writeInteger(digits, length)) + "\n");
 }
 
 } // namespace containers
-} // namespace cmm
\ No newline at end of file
+} // namespace cmm
@@ -0,0 +1,74 @@
+#include <siminusminus/containers/inmutablestringstorage.hpp>
+#include <algorithm>
+
+namespace cmm {
+namespace containers {
+
+namespace {
+
+// Arena of the innermost StringArena::Scope of the thread, if any
+thread_local StringArena* currentArena = nullptr;
+
+} // namespace
+
+////////////////////////
+// StringArena::Scope
+////////////////////////
+
+StringArena::Scope::Scope(StringArena& arena): _previous(currentArena)
+{
+    currentArena = &arena;
+}
+
+StringArena::Scope::~Scope()
+{
+    currentArena = _previous;
+}
+
+///////////////
+// StringArena
+///////////////
+
+StringArena::StringArena(std::size_t blockSize):
+    _blockSize(blockSize),
+    _current(nullptr),
+    _used(0),
+    _capacity(0),
+    _total(0)
+{
+}
+
+StringArena::~StringArena()
+{
+    for (char* block : _blocks)
+        delete[] block;
+}
+
+std::size_t StringArena::capacity() const
+{
+    return _total;
+}
+
+StringArena& StringArena::current()
+{
+    thread_local StringArena threadArena;
+
+    return currentArena != nullptr ? *currentArena : threadArena;
+}
+
+void* StringArena::allocateSlow(std::size_t size)
+{
+    // new[] returns memory aligned for any fundamental type, so offset 0 is always aligned
+    const std::size_t capacity = std::max(size, _blockSize);
+
+    _blocks.push_back(new char[capacity]);
+    _current = _blocks.back();
+    _capacity = capacity;
+    _used = size;
+    _total += capacity;
+
+    return _current;
+}
+
+} // namespace containers
+} // namespace cmm
@@ -0,0 +1,905 @@
+#include <siminusminus/containers/numericconversions.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <locale.h>
+
+#if defined(__APPLE__)
+    #include <xlocale.h>
+#endif
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_M_X64) || defined(_M_IX86)
+    #define SIMINUSMINUS_NUMERICCONVERSIONS_SWAR
+#endif
+
+namespace cmm {
+namespace containers {
+
+const std::size_t NumericBufferSize::Integer;
+const std::size_t NumericBufferSize::FloatingPoint;
+
+namespace {
+
+const char DigitPairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+const double ExactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+bool isDigit(const char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+#ifdef SIMINUSMINUS_NUMERICCONVERSIONS_SWAR
+/**
+ * If the eight characters at text are digits, stores their value in value and returns true.
+ * The eight digits are combined in three multiplications over a 64 bit word.
+ */
+bool parseEightDigits(const char* text, std::uint64_t& value)
+{
+    std::uint64_t chunk;
+    std::memcpy(&chunk, text, sizeof(chunk));
+
+    // Each byte must be in [0x30, 0x39]: high nibble 3, and still 3 after adding 6
+    if (((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) != 0x3333333333333333ull)
+        return false;
+
+    chunk -= 0x3030303030303030ull;
+    chunk = chunk * 10 + (chunk >> 8); // Pairs of digits
+    chunk = ((chunk & 0x000000FF000000FFull) * (100 + (1000000ull << 32)) +
+             ((chunk >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32))) >> 32;
+
+    value = chunk;
+    return true;
+}
+#endif
+
+/**
+ * Returns true if [first, last) starts with word, ignoring the case.
+ */
+bool startsWithNoCase(const char* first, const char* last, const char* word)
+{
+    for (; *word != '\0'; ++first, ++word)
+        if (first == last || (*first | 0x20) != *word)
+            return false;
+
+    return true;
+}
+
+#if defined(_WIN32)
+typedef _locale_t Locale;
+
+/**
+ * Returns the "C" locale. The C library conversions use it instead of the global locale,
+ * whose decimal separator may not be a '.'.
+ */
+Locale classicLocale()
+{
+    static const Locale locale = _create_locale(LC_ALL, "C");
+    return locale;
+}
+
+/**
+ * Converts text to T with the C library, which rounds correctly in every case.
+ */
+double convert(const char* text, char** end, double)
+{
+    return _strtod_l(text, end, classicLocale());
+}
+
+float convert(const char* text, char** end, float)
+{
+    return _strtof_l(text, end, classicLocale());
+}
+
+/**
+ * Formats value in scientific notation with the given number of decimals.
+ */
+int printScientific(char* buffer, std::size_t size, int decimals, double value)
+{
+    return _snprintf_l(buffer, size, "%.*e", classicLocale(), decimals, value);
+}
+#else
+typedef locale_t Locale;
+
+/**
+ * Returns the "C" locale. The C library conversions use it instead of the global locale,
+ * whose decimal separator may not be a '.'.
+ */
+Locale classicLocale()
+{
+    static const Locale locale = newlocale(LC_ALL_MASK, "C", static_cast<locale_t>(0));
+    return locale;
+}
+
+/**
+ * Converts text to T with the C library, which rounds correctly in every case.
+ */
+double convert(const char* text, char** end, double)
+{
+    return strtod_l(text, end, classicLocale());
+}
+
+float convert(const char* text, char** end, float)
+{
+    return strtof_l(text, end, classicLocale());
+}
+
+/**
+ * Formats value in scientific notation with the given number of decimals.
+ */
+int printScientific(char* buffer, std::size_t size, int decimals, double value)
+{
+    // snprintf has no locale parameter, so the thread uses the "C" locale meanwhile
+    const locale_t previous = uselocale(classicLocale());
+    const int length = std::snprintf(buffer, size, "%.*e", decimals, value);
+    uselocale(previous);
+
+    return length;
+}
+#endif
+
+/**
+ * Limits of the exact conversion of a mantissa and a power of ten to T.
+ */
+template <typename T>
+struct FastPathLimits;
+
+template <>
+struct FastPathLimits<double>
+{
+    static const std::uint64_t Mantissa = 1ull << 53;
+    static const int Exponent = 22;
+};
+
+template <>
+struct FastPathLimits<float>
+{
+    static const std::uint64_t Mantissa = 1ull << 24;
+    static const int Exponent = 10;
+};
+
+/**
+ * Layout of the binary representation of T.
+ */
+template <typename T>
+struct FloatLayout;
+
+template <>
+struct FloatLayout<double>
+{
+    typedef std::uint64_t Bits;
+    static const int SignificandBits = 52;
+    static const int ExponentMask = 0x7FF;
+    static const int ExponentBias = 1023 + 52; // Of the significand taken as an integer
+};
+
+template <>
+struct FloatLayout<float>
+{
+    typedef std::uint32_t Bits;
+    static const int SignificandBits = 23;
+    static const int ExponentMask = 0xFF;
+    static const int ExponentBias = 127 + 23;
+};
+
+/**
+ * Number f * 2^e, with a 64 bit significand and no hidden bit.
+ */
+struct DiyFp
+{
+    std::uint64_t f;
+    int e;
+};
+
+DiyFp subtract(const DiyFp& a, const DiyFp& b)
+{
+    return DiyFp{a.f - b.f, a.e};
+}
+
+/**
+ * Returns the product, keeping the rounded upper 64 bits of the significand.
+ */
+DiyFp multiply(const DiyFp& a, const DiyFp& b)
+{
+    const std::uint64_t mask = 0xFFFFFFFFull;
+    const std::uint64_t high = (a.f >> 32) * (b.f >> 32);
+    const std::uint64_t middle1 = (a.f & mask) * (b.f >> 32);
+    const std::uint64_t middle2 = (a.f >> 32) * (b.f & mask);
+    const std::uint64_t low = (a.f & mask) * (b.f & mask);
+    const std::uint64_t carry = (low >> 32) + (middle1 & mask) + (middle2 & mask) + (1ull << 31);
+
+    return DiyFp{high + (middle1 >> 32) + (middle2 >> 32) + (carry >> 32), a.e + b.e + 64};
+}
+
+DiyFp normalize(DiyFp value)
+{
+    while ((value.f & (1ull << 63)) == 0)
+    {
+        value.f <<= 1;
+        --value.e;
+    }
+
+    return value;
+}
+
+/**
+ * Returns a positive finite value as a DiyFp. lowerBoundaryCloser is set if the previous
+ * number of T is closer than the next one, which happens at powers of two.
+ */
+template <typename T>
+DiyFp decompose(T value, bool& lowerBoundaryCloser)
+{
+    typedef FloatLayout<T> Layout;
+    typename Layout::Bits bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const std::uint64_t significand = bits & ((typename Layout::Bits(1) << Layout::SignificandBits) - 1);
+    const int exponent = static_cast<int>(bits >> Layout::SignificandBits) & Layout::ExponentMask;
+
+    if (exponent == 0) // Subnormal
+    {
+        lowerBoundaryCloser = false;
+        return DiyFp{significand, 1 - Layout::ExponentBias};
+    }
+
+    lowerBoundaryCloser = significand == 0 && exponent > 1;
+    return DiyFp{significand | (1ull << Layout::SignificandBits), exponent - Layout::ExponentBias};
+}
+
+/**
+ * Power of ten 10^decimalExponent, rounded to significand * 2^binaryExponent.
+ */
+struct CachedPower
+{
+    std::uint64_t significand;
+    int binaryExponent;
+    int decimalExponent;
+};
+
+const int MinCachedExponent = -348;
+const int CachedExponentStep = 8;
+const int CachedPowerCount = 87; // Up to 10^340
+
+/**
+ * Unsigned integer of any size, only used to compute the cached powers once.
+ */
+class BigInteger
+{
+public:
+
+    explicit BigInteger(std::uint32_t value): _words(1, value) {}
+
+    void multiply(std::uint32_t factor)
+    {
+        std::uint64_t carry = 0;
+
+        for (std::uint32_t& word : _words)
+        {
+            carry += static_cast<std::uint64_t>(word) * factor;
+            word = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+
+        if (carry != 0)
+            _words.push_back(static_cast<std::uint32_t>(carry));
+    }
+
+    /**
+     * Doubles the number and adds bit.
+     */
+    void shiftIn(bool bit)
+    {
+        std::uint32_t carry = bit;
+
+        for (std::uint32_t& word : _words)
+        {
+            const std::uint32_t next = word >> 31;
+            word = (word << 1) | carry;
+            carry = next;
+        }
+
+        if (carry != 0)
+            _words.push_back(carry);
+    }
+
+    bool lessThan(const BigInteger& other) const
+    {
+        const std::size_t words = std::max(_words.size(), other._words.size());
+
+        for (std::size_t i = words; i-- > 0;)
+        {
+            const std::uint32_t mine = i < _words.size() ? _words[i] : 0;
+            const std::uint32_t theirs = i < other._words.size() ? other._words[i] : 0;
+
+            if (mine != theirs)
+                return mine < theirs;
+        }
+
+        return false;
+    }
+
+    /**
+     * Subtracts a number not greater than this one.
+     */
+    void subtract(const BigInteger& other)
+    {
+        std::int64_t borrow = 0;
+
+        for (std::size_t i = 0; i < _words.size(); ++i)
+        {
+            borrow += static_cast<std::int64_t>(_words[i]) - (i < other._words.size() ? other._words[i] : 0);
+            _words[i] = static_cast<std::uint32_t>(borrow);
+            borrow = borrow < 0 ? -1 : 0;
+        }
+
+        while (_words.size() > 1 && _words.back() == 0)
+            _words.pop_back();
+    }
+
+    int bitLength() const
+    {
+        int length = static_cast<int>(_words.size()) * 32;
+
+        for (std::uint32_t top = _words.back(); length > 0 && (top & 0x80000000u) == 0; top <<= 1)
+            --length;
+
+        return length;
+    }
+
+    bool bit(int index) const
+    {
+        return index >= 0 && (_words[static_cast<std::size_t>(index / 32)] >> (index % 32)) & 1;
+    }
+
+private:
+
+    std::vector<std::uint32_t> _words; // Little endian
+};
+
+/**
+ * Computes the powers of ten used to scale numbers into the range of the digit
+ * generation, each one rounded to 64 bits.
+ */
+std::vector<CachedPower> computeCachedPowers()
+{
+    std::vector<CachedPower> powers;
+
+    for (int i = 0; i < CachedPowerCount; ++i)
+    {
+        const int decimalExponent = MinCachedExponent + i * CachedExponentStep;
+        BigInteger power(1);
+
+        for (int j = 0; j < std::abs(decimalExponent); ++j)
+            power.multiply(10);
+
+        const int length = power.bitLength();
+        std::uint64_t significand = 0;
+        int binaryExponent;
+        bool roundUp;
+
+        if (decimalExponent >= 0)
+        {
+            // Keep the top 64 bits
+            for (int bit = length - 1; bit >= length - 64; --bit)
+                significand = significand << 1 | power.bit(bit);
+
+            binaryExponent = length - 64;
+            roundUp = power.bit(length - 65);
+        }
+        else
+        {
+            // 2^shift / 10^-decimalExponent has 64 bits
+            const int shift = length + 63;
+            BigInteger remainder(0);
+
+            for (int bit = shift; bit >= 0; --bit)
+            {
+                remainder.shiftIn(bit == shift);
+                const bool fits = !remainder.lessThan(power);
+
+                if (fits)
+                    remainder.subtract(power);
+
+                significand = significand << 1 | fits;
+            }
+
+            remainder.shiftIn(false);
+            binaryExponent = -shift;
+            roundUp = !remainder.lessThan(power);
+        }
+
+        if (roundUp && ++significand == 0)
+        {
+            significand = 1ull << 63;
+            ++binaryExponent;
+        }
+
+        powers.push_back(CachedPower{significand, binaryExponent, decimalExponent});
+    }
+
+    return powers;
+}
+
+/**
+ * Returns a cached power of ten c such that e + 64 + c.binaryExponent is in
+ * [minExponent, maxExponent] for the DiyFp exponents e the range was built from.
+ */
+const CachedPower& cachedPower(int minExponent)
+{
+    static const std::vector<CachedPower> powers = computeCachedPowers();
+
+    const double log10Of2 = 0.30102999566398114;
+    const int k = static_cast<int>(std::ceil((minExponent + 64 - 1) * log10Of2));
+
+    return powers[static_cast<std::size_t>((k - MinCachedExponent - 1) / CachedExponentStep + 1)];
+}
+
+/**
+ * Final digit adjustment of Grisu3. Moves the last digit towards w while it stays in
+ * the safe interval, and returns false if the result may not be the closest shortest
+ * representation.
+ */
+bool roundWeed(char* digits, int length, std::uint64_t distanceTooHighW, std::uint64_t unsafeInterval,
+               std::uint64_t rest, std::uint64_t tenKappa, std::uint64_t unit)
+{
+    const std::uint64_t smallDistance = distanceTooHighW - unit;
+    const std::uint64_t bigDistance = distanceTooHighW + unit;
+
+    while (rest < smallDistance && unsafeInterval - rest >= tenKappa &&
+           (rest + tenKappa < smallDistance || smallDistance - rest >= rest + tenKappa - smallDistance))
+    {
+        --digits[length - 1];
+        rest += tenKappa;
+    }
+
+    if (rest < bigDistance && unsafeInterval - rest >= tenKappa &&
+        (rest + tenKappa < bigDistance || bigDistance - rest > rest + tenKappa - bigDistance))
+    {
+        return false;
+    }
+
+    return 2 * unit <= rest && rest <= unsafeInterval - 4 * unit;
+}
+
+/**
+ * Grisu3 digit generation for the scaled number w and its scaled boundaries. Fails in
+ * the rare cases where the shortest digits cannot be proven correct.
+ */
+bool generateDigits(const DiyFp& low, const DiyFp& w, const DiyFp& high, char* digits, int& length, int& kappa)
+{
+    std::uint64_t unit = 1;
+    const DiyFp tooLow{low.f - unit, low.e};
+    const DiyFp tooHigh{high.f + unit, high.e};
+    DiyFp unsafeInterval = subtract(tooHigh, tooLow);
+    const DiyFp one{1ull << -w.e, w.e};
+
+    std::uint32_t integrals = static_cast<std::uint32_t>(tooHigh.f >> -one.e);
+    std::uint64_t fractionals = tooHigh.f & (one.f - 1);
+    std::uint32_t divisor = 0;
+    kappa = 0;
+
+    if (integrals != 0)
+    {
+        divisor = 1;
+        kappa = 1;
+
+        while (integrals / 10 >= divisor)
+        {
+            divisor *= 10;
+            ++kappa;
+        }
+    }
+
+    length = 0;
+
+    for (; kappa > 0; divisor /= 10)
+    {
+        digits[length++] = static_cast<char>('0' + integrals / divisor);
+        integrals %= divisor;
+        --kappa;
+
+        const std::uint64_t rest = (static_cast<std::uint64_t>(integrals) << -one.e) + fractionals;
+
+        if (rest < unsafeInterval.f)
+            return roundWeed(digits, length, subtract(tooHigh, w).f, unsafeInterval.f, rest,
+                             static_cast<std::uint64_t>(divisor) << -one.e, unit);
+    }
+
+    while (true)
+    {
+        fractionals *= 10;
+        unit *= 10;
+        unsafeInterval.f *= 10;
+
+        digits[length++] = static_cast<char>('0' + (fractionals >> -one.e));
+        fractionals &= one.f - 1;
+        --kappa;
+
+        if (fractionals < unsafeInterval.f)
+            return roundWeed(digits, length, subtract(tooHigh, w).f * unit, unsafeInterval.f, fractionals, one.f, unit);
+    }
+}
+
+/**
+ * Finds the shortest digits that parse back to a positive finite value, closest to it,
+ * such that value = digits * 10^exponent. Returns false if Grisu3 cannot prove them.
+ */
+template <typename T>
+bool shortestDigits(T value, char* digits, int& length, int& exponent)
+{
+    bool lowerBoundaryCloser;
+    const DiyFp v = decompose(value, lowerBoundaryCloser);
+    const DiyFp w = normalize(v);
+
+    // Boundaries halfway to the neighbours of value, with the exponent of w
+    const DiyFp plus = normalize(DiyFp{(v.f << 1) + 1, v.e - 1});
+    DiyFp minus = lowerBoundaryCloser ? DiyFp{(v.f << 2) - 1, v.e - 2} : DiyFp{(v.f << 1) - 1, v.e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    // Scale so that the integral part of w fits in 32 bits
+    const CachedPower& power = cachedPower(-60 - (w.e + 64));
+    const DiyFp scale{power.significand, power.binaryExponent};
+    int kappa;
+
+    if (!generateDigits(multiply(minus, scale), multiply(w, scale), multiply(plus, scale), digits, length, kappa))
+        return false;
+
+    exponent = kappa - power.decimalExponent;
+    return true;
+}
+
+/**
+ * shortestDigits() with the C library, for the numbers Grisu3 fails on: tries every
+ * number of digits until one parses back to value.
+ */
+template <typename T>
+void shortestDigitsFallback(T value, char* digits, int& length, int& exponent)
+{
+    char buffer[32];
+
+    for (int decimals = 0; decimals < std::numeric_limits<T>::max_digits10; ++decimals)
+    {
+        printScientific(buffer, sizeof(buffer), decimals, value);
+
+        if (convert(buffer, nullptr, T()) == value)
+            break;
+    }
+
+    // buffer holds d[.ddd]e[+-]xx
+    const char* it = buffer;
+    length = 0;
+
+    for (; *it != 'e'; ++it)
+        if (isDigit(*it))
+            digits[length++] = *it;
+
+    exponent = std::atoi(it + 1) - (length - 1);
+}
+
+/**
+ * Writes digits * 10^exponent like printf's %g with the given precision, without
+ * trailing zeros.
+ */
+char* writeDecimal(char* out, const char* digits, int length, int exponent, int precision)
+{
+    const int scientificExponent = length + exponent - 1;
+
+    if (scientificExponent < -4 || scientificExponent >= precision)
+    {
+        *out++ = digits[0];
+
+        if (length > 1)
+        {
+            *out++ = '.';
+            std::memcpy(out, digits + 1, static_cast<std::size_t>(length - 1));
+            out += length - 1;
+        }
+
+        *out++ = 'e';
+        *out++ = scientificExponent < 0 ? '-' : '+';
+
+        const int magnitude = std::abs(scientificExponent);
+
+        if (magnitude < 10)
+            *out++ = '0';
+
+        return detail::writeDigits(out, static_cast<std::uint64_t>(magnitude));
+    }
+
+    if (scientificExponent < 0)
+    {
+        *out++ = '0';
+        *out++ = '.';
+        std::memset(out, '0', static_cast<std::size_t>(-scientificExponent - 1));
+        out += -scientificExponent - 1;
+        std::memcpy(out, digits, static_cast<std::size_t>(length));
+        return out + length;
+    }
+
+    const int integralDigits = scientificExponent + 1;
+
+    if (length <= integralDigits)
+    {
+        std::memcpy(out, digits, static_cast<std::size_t>(length));
+        out += length;
+        std::memset(out, '0', static_cast<std::size_t>(integralDigits - length));
+        return out + integralDigits - length;
+    }
+
+    std::memcpy(out, digits, static_cast<std::size_t>(integralDigits));
+    out += integralDigits;
+    *out++ = '.';
+    std::memcpy(out, digits + integralDigits, static_cast<std::size_t>(length - integralDigits));
+
+    return out + length - integralDigits;
+}
+
+} // namespace
+
+namespace detail {
+
+const char* parseDigits(const char* first, const char* last, std::uint64_t& value, bool& overflow)
+{
+    const char* it = first;
+    value = 0;
+    overflow = false;
+
+#ifdef SIMINUSMINUS_NUMERICCONVERSIONS_SWAR
+    // Up to 19 digits always fit in 64 bits
+    std::uint64_t eight;
+
+    while (last - it >= 8 && it - first <= 11 && parseEightDigits(it, eight))
+    {
+        value = value * 100000000u + eight;
+        it += 8;
+    }
+#endif
+
+    for (; it != last && isDigit(*it); ++it)
+    {
+        const unsigned digit = static_cast<unsigned>(*it - '0');
+
+        if (value > (std::numeric_limits<std::uint64_t>::max() - digit) / 10)
+            overflow = true;
+        else if (!overflow)
+            value = value * 10 + digit;
+    }
+
+    return it;
+}
+
+char* writeDigits(char* out, std::uint64_t value)
+{
+    std::size_t digits = 1;
+
+    for (std::uint64_t rest = value; rest >= 10; rest /= 10)
+        ++digits;
+
+    char* const end = out + digits;
+    char* it = end;
+
+    while (value >= 100)
+    {
+        const std::size_t pair = static_cast<std::size_t>(value % 100) * 2;
+        value /= 100;
+        *--it = DigitPairs[pair + 1];
+        *--it = DigitPairs[pair];
+    }
+
+    if (value >= 10)
+    {
+        *--it = DigitPairs[value * 2 + 1];
+        *--it = DigitPairs[value * 2];
+    }
+    else
+    {
+        *--it = static_cast<char>('0' + value);
+    }
+
+    return end;
+}
+
+} // namespace detail
+
+template <typename T>
+ParseResult<T> parseFloatingPoint(const ConstContiguousView<char>& text)
+{
+    const char* const first = text.data();
+    const char* const last = first + text.size();
+    const char* it = first;
+    const bool negative = it != last && *it == '-';
+
+    if (negative)
+        ++it;
+
+    if (startsWithNoCase(it, last, "inf"))
+    {
+        const std::size_t length = startsWithNoCase(it, last, "infinity") ? 8 : 3;
+        const T infinity = std::numeric_limits<T>::infinity();
+
+        return ParseResult<T>{negative ? -infinity : infinity, static_cast<std::size_t>(it - first) + length, ParseError::None};
+    }
+
+    if (startsWithNoCase(it, last, "nan"))
+        return ParseResult<T>{std::numeric_limits<T>::quiet_NaN(), static_cast<std::size_t>(it - first) + 3, ParseError::None};
+
+    // Keep the first 19 significant digits in the mantissa and track the decimal exponent
+    std::uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool digits = false;
+
+    for (; it != last && isDigit(*it); ++it)
+    {
+        const unsigned digit = static_cast<unsigned>(*it - '0');
+        digits = true;
+
+        if (significant < 19 && (mantissa != 0 || digit != 0))
+        {
+            mantissa = mantissa * 10 + digit;
+            ++significant;
+        }
+        else if (significant >= 19)
+        {
+            ++exponent;
+            truncated |= digit != 0;
+        }
+    }
+
+    if (it != last && *it == '.')
+    {
+        for (++it; it != last && isDigit(*it); ++it)
+        {
+            const unsigned digit = static_cast<unsigned>(*it - '0');
+            digits = true;
+
+            if (significant < 19 && (mantissa != 0 || digit != 0))
+            {
+                mantissa = mantissa * 10 + digit;
+                ++significant;
+                --exponent;
+            }
+            else if (significant >= 19)
+            {
+                truncated |= digit != 0;
+            }
+            else
+            {
+                --exponent; // Leading zero of the fraction
+            }
+        }
+    }
+
+    if (!digits)
+        return ParseResult<T>{T(), 0, ParseError::InvalidInput};
+
+    // The exponent is only consumed if it has digits
+    if (it != last && (*it == 'e' || *it == 'E'))
+    {
+        const char* exponentIt = it + 1;
+        const bool negativeExponent = exponentIt != last && *exponentIt == '-';
+
+        if (exponentIt != last && (*exponentIt == '-' || *exponentIt == '+'))
+            ++exponentIt;
+
+        if (exponentIt != last && isDigit(*exponentIt))
+        {
+            int value = 0;
+
+            for (; exponentIt != last && isDigit(*exponentIt); ++exponentIt)
+                if (value < 100000) // Far beyond any finite result
+                    value = value * 10 + (*exponentIt - '0');
+
+            exponent += negativeExponent ? -value : value;
+            it = exponentIt;
+        }
+    }
+
+    const std::size_t consumed = static_cast<std::size_t>(it - first);
+
+    if (mantissa == 0)
+        return ParseResult<T>{negative ? -T() : T(), consumed, ParseError::None};
+
+    // Both the mantissa and the power of ten are exact, so there is only one rounding
+    if (!truncated && mantissa <= FastPathLimits<T>::Mantissa &&
+        exponent >= -FastPathLimits<T>::Exponent && exponent <= FastPathLimits<T>::Exponent)
+    {
+        T value = static_cast<T>(mantissa);
+        const T power = static_cast<T>(ExactPowersOfTen[exponent < 0 ? -exponent : exponent]);
+
+        value = exponent < 0 ? value / power : value * power;
+        return ParseResult<T>{negative ? -value : value, consumed, ParseError::None};
+    }
+
+    // Slow path. The C library needs a null terminated copy
+    char local[64];
+    std::string remote;
+    char* copy = local;
+
+    if (consumed >= sizeof(local))
+    {
+        remote.assign(first, consumed);
+        copy = &remote[0];
+    }
+    else
+    {
+        std::memcpy(local, first, consumed);
+        local[consumed] = '\0';
+    }
+
+    errno = 0;
+    const T value = convert(copy, nullptr, T());
+
+    if (errno == ERANGE && (std::isinf(value) || value == T()))
+        return ParseResult<T>{value, consumed, ParseError::OutOfRange};
+
+    return ParseResult<T>{value, consumed, ParseError::None};
+}
+
+template <typename T>
+char* writeFloatingPoint(char* out, T value)
+{
+    if (std::isnan(value))
+    {
+        std::memcpy(out, "nan", 3);
+        return out + 3;
+    }
+
+    if (std::isinf(value))
+    {
+        if (value < 0)
+            *out++ = '-';
+
+        std::memcpy(out, "inf", 3);
+        return out + 3;
+    }
+
+    if (std::signbit(value))
+    {
+        *out++ = '-';
+        value = -value;
+    }
+
+    if (value == T())
+    {
+        *out++ = '0';
+        return out;
+    }
+
+    char digits[32];
+    int length;
+    int exponent;
+
+    if (!shortestDigits(value, digits, length, exponent))
+        shortestDigitsFallback(value, digits, length, exponent);
+
+    for (; length > 1 && digits[length - 1] == '0'; --length)
+        ++exponent;
+
+    // Like %g with the smallest precision of at least digits10 that round trips
+    return writeDecimal(out, digits, length, exponent, std::max(std::numeric_limits<T>::digits10, length));
+}
+
+template ParseResult<float> parseFloatingPoint<float>(const ConstContiguousView<char>& text);
+template ParseResult<double> parseFloatingPoint<double>(const ConstContiguousView<char>& text);
+template char* writeFloatingPoint<float>(char* out, float value);
+template char* writeFloatingPoint<double>(char* out, double value);
+
+} // namespace containers
+} // namespace cmm
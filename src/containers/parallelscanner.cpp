@@ -0,0 +1,281 @@
+#include <siminusminus/containers/parallelscanner.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SIMINUSMINUS_PARALLELSCANNER_SSE2
+#endif
+
+namespace cmm {
+namespace containers {
+
+namespace {
+
+const std::size_t CacheLineSize = 64;
+
+/**
+ * Counts the occurrences of byte in [from, to).
+ */
+std::size_t countByte(const char* from, const char* to, char byte)
+{
+    std::size_t total = 0;
+
+#ifdef SIMINUSMINUS_PARALLELSCANNER_SSE2
+    const __m128i needle = _mm_set1_epi8(byte);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (to - from >= 16)
+    {
+        // Each 8 bit lane counts up to 255 blocks before being flushed
+        __m128i lanes = _mm_setzero_si128();
+        const std::size_t blocks = std::min<std::size_t>(static_cast<std::size_t>(to - from) / 16, 255);
+
+        for (std::size_t i = 0; i < blocks; ++i, from += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(block, needle)); // Matches are -1
+        }
+
+        const __m128i sums = _mm_sad_epu8(lanes, zero);
+        total += static_cast<std::size_t>(_mm_cvtsi128_si32(sums)) +
+                 static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+#endif
+
+    for (; from != to; ++from)
+        total += *from == byte;
+
+    return total;
+}
+
+/**
+ * Returns the first occurrence of needle starting in [from, lastStart), reading no
+ * further than textEnd, or nullptr if there is none.
+ */
+const char* searchFrom(const char* from, const char* lastStart, const char* textEnd,
+                       const ConstContiguousView<char>& needle)
+{
+    const std::size_t length = needle.size();
+
+    if (static_cast<std::size_t>(textEnd - from) < length)
+        return nullptr;
+
+    // Occurrences must end before textEnd
+    if (static_cast<std::size_t>(textEnd - lastStart) < length - 1)
+        lastStart = textEnd - (length - 1);
+
+    while (from < lastStart)
+    {
+        const void* hit = std::memchr(from, needle.data()[0], static_cast<std::size_t>(lastStart - from));
+
+        if (hit == nullptr)
+            return nullptr;
+
+        const char* candidate = static_cast<const char*>(hit);
+
+        if (std::memcmp(candidate + 1, needle.data() + 1, length - 1) == 0)
+            return candidate;
+
+        from = candidate + 1;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Lowers value to candidate if candidate is smaller.
+ */
+void atomicMin(std::atomic<std::size_t>& value, std::size_t candidate)
+{
+    std::size_t current = value.load();
+
+    while (candidate < current && !value.compare_exchange_weak(current, candidate))
+    {
+    }
+}
+
+} // namespace
+
+///////////////////
+// ParallelScanner
+///////////////////
+
+const std::size_t ParallelScanner::NotFound;
+const std::size_t ParallelScanner::DefaultChunkSize;
+
+ParallelScanner::ParallelScanner(utils::ThreadPool& pool, std::size_t chunkSize):
+    _pool(pool),
+    _chunkSize(std::max(CacheLineSize, (chunkSize + CacheLineSize - 1) / CacheLineSize * CacheLineSize))
+{
+}
+
+std::size_t ParallelScanner::count(const ConstContiguousView<char>& view, char byte) const
+{
+    return reduce(view, std::size_t(0),
+        [byte](const ConstContiguousView<char>& chunk)
+        {
+            return countByte(chunk.data(), chunk.data() + chunk.size(), byte);
+        },
+        [](std::size_t lhs, std::size_t rhs)
+        {
+            return lhs + rhs;
+        });
+}
+
+std::size_t ParallelScanner::findFirst(const ConstContiguousView<char>& view, char byte) const
+{
+    const std::vector<ConstContiguousView<char>> parts = chunks(view);
+    std::atomic<std::size_t> first(NotFound);
+
+    _pool.parallelFor(parts.size(), [&](std::size_t i)
+    {
+        const std::size_t offset = static_cast<std::size_t>(parts[i].data() - view.data());
+
+        if (offset >= first.load()) // An earlier chunk already has one
+            return;
+
+        const void* hit = std::memchr(parts[i].data(), byte, parts[i].size());
+
+        if (hit != nullptr)
+            atomicMin(first, static_cast<std::size_t>(static_cast<const char*>(hit) - view.data()));
+    });
+
+    return first.load();
+}
+
+std::size_t ParallelScanner::findFirst(const ConstContiguousView<char>& view, const ConstContiguousView<char>& needle) const
+{
+    if (needle.empty())
+        return 0;
+
+    const std::vector<ConstContiguousView<char>> parts = chunks(view);
+    const char* const textEnd = view.data() + view.size();
+    std::atomic<std::size_t> first(NotFound);
+
+    _pool.parallelFor(parts.size(), [&](std::size_t i)
+    {
+        const std::size_t offset = static_cast<std::size_t>(parts[i].data() - view.data());
+
+        if (offset >= first.load())
+            return;
+
+        // Occurrences starting in this chunk may end in the following ones
+        const char* hit = searchFrom(parts[i].data(), parts[i].data() + parts[i].size(), textEnd, needle);
+
+        if (hit != nullptr)
+            atomicMin(first, static_cast<std::size_t>(hit - view.data()));
+    });
+
+    return first.load();
+}
+
+std::vector<std::size_t> ParallelScanner::findAll(const ConstContiguousView<char>& view, const ConstContiguousView<char>& needle) const
+{
+    const std::vector<ConstContiguousView<char>> parts = chunks(view);
+    const char* const textEnd = view.data() + view.size();
+    std::vector<std::vector<std::size_t>> found(parts.size());
+    std::vector<std::size_t> all;
+
+    if (needle.empty())
+        return all;
+
+    _pool.parallelFor(parts.size(), [&](std::size_t i)
+    {
+        const char* from = parts[i].data();
+        const char* const lastStart = from + parts[i].size();
+
+        while ((from = searchFrom(from, lastStart, textEnd, needle)) != nullptr)
+        {
+            found[i].push_back(static_cast<std::size_t>(from - view.data()));
+            ++from;
+        }
+    });
+
+    std::size_t total = 0;
+
+    for (const std::vector<std::size_t>& offsets : found)
+        total += offsets.size();
+
+    all.reserve(total);
+
+    for (const std::vector<std::size_t>& offsets : found)
+        all.insert(all.end(), offsets.begin(), offsets.end());
+
+    return all;
+}
+
+std::array<std::size_t, 256> ParallelScanner::histogram(const ConstContiguousView<char>& view) const
+{
+    std::array<std::size_t, 256> empty;
+    empty.fill(0);
+
+    return reduce(view, empty,
+        [](const ConstContiguousView<char>& chunk)
+        {
+            // Four interleaved tables, so consecutive equal bytes do not serialize on one counter
+            std::array<std::array<std::size_t, 256>, 4> tables;
+
+            for (std::array<std::size_t, 256>& table : tables)
+                table.fill(0);
+
+            const unsigned char* it = reinterpret_cast<const unsigned char*>(chunk.data());
+            const unsigned char* const end = it + chunk.size();
+
+            for (; end - it >= 4; it += 4)
+            {
+                ++tables[0][it[0]];
+                ++tables[1][it[1]];
+                ++tables[2][it[2]];
+                ++tables[3][it[3]];
+            }
+
+            for (; it != end; ++it)
+                ++tables[0][*it];
+
+            for (std::size_t byte = 0; byte < 256; ++byte)
+                tables[0][byte] += tables[1][byte] + tables[2][byte] + tables[3][byte];
+
+            return tables[0];
+        },
+        [](std::array<std::size_t, 256> lhs, const std::array<std::size_t, 256>& rhs)
+        {
+            for (std::size_t byte = 0; byte < 256; ++byte)
+                lhs[byte] += rhs[byte];
+
+            return lhs;
+        });
+}
+
+std::vector<ConstContiguousView<char>> ParallelScanner::chunks(const ConstContiguousView<char>& view) const
+{
+    std::vector<ConstContiguousView<char>> parts;
+    const char* from = view.data();
+    const char* const end = from + view.size();
+
+    while (from != end)
+    {
+        const char* to = end;
+
+        if (static_cast<std::size_t>(end - from) > _chunkSize)
+        {
+            // Cut at the start of the cache line holding from + _chunkSize
+            to = from + _chunkSize;
+            to -= reinterpret_cast<std::uintptr_t>(to) % CacheLineSize;
+        }
+
+        parts.emplace_back(from, to);
+        from = to;
+    }
+
+    return parts;
+}
+
+std::size_t ParallelScanner::chunkSize() const
+{
+    return _chunkSize;
+}
+
+} // namespace containers
+} // namespace cmm
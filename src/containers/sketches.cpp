@@ -0,0 +1,519 @@
+#include <siminusminus/containers/sketches.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace cmm {
+namespace containers {
+
+namespace {
+
+// Serialized sketches start with one of these tags, followed by their parameters and
+// their contents, in native byte order
+const char BloomFilterTag[4] = {'C', 'M', 'B', 'F'};
+const char HyperLogLogTag[4] = {'C', 'M', 'H', 'L'};
+const char CountMinSketchTag[4] = {'C', 'M', 'C', 'M'};
+
+const std::uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+const std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+const std::uint64_t Prime3 = 0x165667B19E3779F9ull;
+const std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+
+const std::size_t WordsPerBlock = 8;
+
+std::uint64_t rotateLeft(std::uint64_t value, unsigned int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+std::uint64_t mixWord(std::uint64_t word)
+{
+    return rotateLeft(word * Prime2, 31) * Prime1;
+}
+
+/**
+ * Returns the word giving the Bloom filter bits of a group of 7 probes. Every group is
+ * derived from the hash itself, so all of them are independent.
+ */
+std::uint64_t probeWord(std::uint64_t hash, std::size_t group)
+{
+    return mixWord(hash + group * 0x9E3779B97F4A7C15ull);
+}
+
+unsigned int leadingZeros(std::uint64_t value)
+{
+#if defined(__GNUC__)
+    return value == 0 ? 64 : static_cast<unsigned int>(__builtin_clzll(value));
+#else
+    unsigned int zeros = 0;
+
+    for (std::uint64_t bit = std::uint64_t(1) << 63; bit != 0 && (value & bit) == 0; bit >>= 1)
+        ++zeros;
+
+    return zeros;
+#endif
+}
+
+void append(std::vector<char>& bytes, const void* data, std::size_t size)
+{
+    const char* begin = static_cast<const char*>(data);
+    bytes.insert(bytes.end(), begin, begin + size);
+}
+
+/**
+ * Reads size bytes at offset, advancing it. Returns false if there are not enough bytes.
+ */
+bool read(const ConstContiguousView<char>& bytes, std::size_t& offset, void* data, std::size_t size)
+{
+    if (bytes.size() - offset < size)
+        return false;
+
+    std::memcpy(data, bytes.data() + offset, size);
+    offset += size;
+
+    return true;
+}
+
+bool readTag(const ConstContiguousView<char>& bytes, std::size_t& offset, const char (&tag)[4])
+{
+    char found[4];
+    return read(bytes, offset, found, sizeof(found)) && std::memcmp(found, tag, sizeof(tag)) == 0;
+}
+
+} // namespace
+
+std::uint64_t hashKey(const ConstContiguousView<char>& key)
+{
+    // Single lane of xxHash64
+    const char* data = key.data();
+    const std::size_t length = key.size();
+    std::uint64_t hash = Prime3 ^ (length * Prime1);
+    std::size_t i = 0;
+
+    for (; i + 8 <= length; i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+
+        hash ^= mixWord(word);
+        hash = rotateLeft(hash, 27) * Prime1 + Prime4;
+    }
+
+    if (i < length)
+    {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data + i, length - i);
+
+        hash ^= mixWord(word);
+        hash = rotateLeft(hash, 27) * Prime1 + Prime4;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+namespace detail {
+
+/////////////////////
+// CacheAlignedWords
+/////////////////////
+
+CacheAlignedWords::CacheAlignedWords(std::size_t count):
+    _storage(count + WordsPerBlock - 1, 0),
+    _count(count)
+{
+}
+
+CacheAlignedWords::CacheAlignedWords(const CacheAlignedWords& other):
+    CacheAlignedWords(other._count)
+{
+    std::copy(other.data(), other.data() + _count, data());
+}
+
+CacheAlignedWords& CacheAlignedWords::operator=(const CacheAlignedWords& other)
+{
+    CacheAlignedWords copy(other);
+    return *this = std::move(copy);
+}
+
+std::uint64_t* CacheAlignedWords::data()
+{
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(_storage.data());
+    const std::size_t misalignment = (address / sizeof(std::uint64_t)) % WordsPerBlock;
+
+    return _storage.data() + (WordsPerBlock - misalignment) % WordsPerBlock;
+}
+
+const std::uint64_t* CacheAlignedWords::data() const
+{
+    return const_cast<CacheAlignedWords*>(this)->data();
+}
+
+std::size_t CacheAlignedWords::size() const
+{
+    return _count;
+}
+
+} // namespace detail
+
+///////////////
+// BloomFilter
+///////////////
+
+const std::size_t BloomFilter::DefaultHashes;
+
+BloomFilter::BloomFilter(std::size_t bytes, std::size_t hashes):
+    _blocks(std::max<std::size_t>(1, (bytes + 63) / 64)),
+    _hashes(std::max<std::size_t>(1, hashes)),
+    _words(_blocks * WordsPerBlock)
+{
+}
+
+void BloomFilter::insert(const ConstContiguousView<char>& key)
+{
+    insertHash(hashKey(key));
+}
+
+void BloomFilter::insertHash(std::uint64_t hash)
+{
+    // The high half of the hash picks the block, the bits come from remixing it.
+    // Each bit takes 9 bits of a remixed word, so a word gives 7 bits
+    std::uint64_t* block = _words.data() + ((hash >> 32) * _blocks >> 32) * WordsPerBlock;
+    std::uint64_t bits = 0;
+
+    for (std::size_t i = 0; i < _hashes; ++i)
+    {
+        if (i % 7 == 0)
+            bits = probeWord(hash, i / 7);
+
+        const unsigned int bit = bits & 511;
+        block[bit / 64] |= std::uint64_t(1) << (bit % 64);
+        bits >>= 9;
+    }
+}
+
+bool BloomFilter::mayContain(const ConstContiguousView<char>& key) const
+{
+    return mayContainHash(hashKey(key));
+}
+
+bool BloomFilter::mayContainHash(std::uint64_t hash) const
+{
+    const std::uint64_t* block = _words.data() + ((hash >> 32) * _blocks >> 32) * WordsPerBlock;
+    std::uint64_t bits = 0;
+
+    for (std::size_t i = 0; i < _hashes; ++i)
+    {
+        if (i % 7 == 0)
+            bits = probeWord(hash, i / 7);
+
+        const unsigned int bit = bits & 511;
+
+        if ((block[bit / 64] & (std::uint64_t(1) << (bit % 64))) == 0)
+            return false;
+
+        bits >>= 9;
+    }
+
+    return true;
+}
+
+bool BloomFilter::merge(const BloomFilter& other)
+{
+    if (_blocks != other._blocks || _hashes != other._hashes)
+        return false;
+
+    std::uint64_t* words = _words.data();
+    const std::uint64_t* otherWords = other._words.data();
+
+    for (std::size_t i = 0; i < _words.size(); ++i)
+        words[i] |= otherWords[i];
+
+    return true;
+}
+
+std::size_t BloomFilter::serialize(std::vector<char>& bytes) const
+{
+    const std::size_t before = bytes.size();
+    const std::uint32_t hashes = static_cast<std::uint32_t>(_hashes);
+    const std::uint64_t blocks = _blocks;
+
+    append(bytes, BloomFilterTag, sizeof(BloomFilterTag));
+    append(bytes, &hashes, sizeof(hashes));
+    append(bytes, &blocks, sizeof(blocks));
+    append(bytes, _words.data(), _words.size() * sizeof(std::uint64_t));
+
+    return bytes.size() - before;
+}
+
+bool BloomFilter::deserialize(const ConstContiguousView<char>& bytes)
+{
+    std::size_t offset = 0;
+    std::uint32_t hashes;
+    std::uint64_t blocks;
+
+    if (!readTag(bytes, offset, BloomFilterTag) || !read(bytes, offset, &hashes, sizeof(hashes)) ||
+        !read(bytes, offset, &blocks, sizeof(blocks)) || hashes == 0 || blocks == 0 ||
+        (bytes.size() - offset) / (WordsPerBlock * sizeof(std::uint64_t)) != blocks ||
+        (bytes.size() - offset) % (WordsPerBlock * sizeof(std::uint64_t)) != 0)
+    {
+        return false;
+    }
+
+    BloomFilter filter(static_cast<std::size_t>(blocks) * 64, hashes);
+    read(bytes, offset, filter._words.data(), filter._words.size() * sizeof(std::uint64_t));
+
+    *this = std::move(filter);
+    return true;
+}
+
+std::size_t BloomFilter::sizeInBytes() const
+{
+    return _blocks * 64;
+}
+
+///////////////
+// HyperLogLog
+///////////////
+
+const unsigned int HyperLogLog::DefaultPrecision;
+const unsigned int HyperLogLog::MinPrecision;
+const unsigned int HyperLogLog::MaxPrecision;
+
+HyperLogLog::HyperLogLog(unsigned int precision):
+    _precision(std::min(std::max(precision, MinPrecision), MaxPrecision)),
+    _registers(std::size_t(1) << _precision, 0)
+{
+}
+
+void HyperLogLog::insert(const ConstContiguousView<char>& key)
+{
+    insertHash(hashKey(key));
+}
+
+void HyperLogLog::insertHash(std::uint64_t hash)
+{
+    // The high bits pick the register, the rank is the position of the first one in
+    // the rest. The sentinel bit bounds the rank to 64 - precision + 1
+    const std::size_t index = static_cast<std::size_t>(hash >> (64 - _precision));
+    const std::uint64_t rest = (hash << _precision) | (std::uint64_t(1) << (_precision - 1));
+    const std::uint8_t rank = static_cast<std::uint8_t>(leadingZeros(rest) + 1);
+
+    if (_registers[index] < rank)
+        _registers[index] = rank;
+}
+
+double HyperLogLog::estimate() const
+{
+    const double m = static_cast<double>(_registers.size());
+    double sum = 0;
+    std::size_t zeros = 0;
+
+    for (std::uint8_t rank : _registers)
+    {
+        sum += std::ldexp(1.0, -static_cast<int>(rank));
+        zeros += rank == 0;
+    }
+
+    double alpha;
+
+    switch (_registers.size())
+    {
+    case 16: alpha = 0.673; break;
+    case 32: alpha = 0.697; break;
+    case 64: alpha = 0.709; break;
+    default: alpha = 0.7213 / (1 + 1.079 / m);
+    }
+
+    const double raw = alpha * m * m / sum;
+
+    // Small cardinalities are better estimated by the number of empty registers
+    if (raw <= 2.5 * m && zeros != 0)
+        return m * std::log(m / static_cast<double>(zeros));
+
+    return raw;
+}
+
+bool HyperLogLog::merge(const HyperLogLog& other)
+{
+    if (_precision != other._precision)
+        return false;
+
+    for (std::size_t i = 0; i < _registers.size(); ++i)
+        _registers[i] = std::max(_registers[i], other._registers[i]);
+
+    return true;
+}
+
+std::size_t HyperLogLog::serialize(std::vector<char>& bytes) const
+{
+    const std::size_t before = bytes.size();
+    const std::uint32_t precision = _precision;
+
+    append(bytes, HyperLogLogTag, sizeof(HyperLogLogTag));
+    append(bytes, &precision, sizeof(precision));
+    append(bytes, _registers.data(), _registers.size());
+
+    return bytes.size() - before;
+}
+
+bool HyperLogLog::deserialize(const ConstContiguousView<char>& bytes)
+{
+    std::size_t offset = 0;
+    std::uint32_t precision;
+
+    if (!readTag(bytes, offset, HyperLogLogTag) || !read(bytes, offset, &precision, sizeof(precision)) ||
+        precision < MinPrecision || precision > MaxPrecision ||
+        bytes.size() - offset != std::size_t(1) << precision)
+    {
+        return false;
+    }
+
+    HyperLogLog sketch(precision);
+    read(bytes, offset, sketch._registers.data(), sketch._registers.size());
+
+    const std::uint8_t maxRank = static_cast<std::uint8_t>(64 - precision + 1);
+
+    if (std::any_of(sketch._registers.begin(), sketch._registers.end(), [maxRank](std::uint8_t rank) { return rank > maxRank; }))
+        return false;
+
+    *this = std::move(sketch);
+    return true;
+}
+
+unsigned int HyperLogLog::precision() const
+{
+    return _precision;
+}
+
+//////////////////
+// CountMinSketch
+//////////////////
+
+CountMinSketch::CountMinSketch(std::size_t width, std::size_t depth):
+    _width(1),
+    _depth(std::max<std::size_t>(1, depth)),
+    _total(0)
+{
+    // Doubling past the largest power of two would wrap to 0 and loop forever
+    if (width > std::numeric_limits<std::size_t>::max() / 2 + 1)
+        throw std::length_error("CountMinSketch: width too large");
+
+    while (_width < width)
+        _width *= 2;
+
+    if (_depth > _counters.max_size() / _width)
+        throw std::length_error("CountMinSketch: too many counters");
+
+    _counters.assign(_width * _depth, 0);
+}
+
+void CountMinSketch::insert(const ConstContiguousView<char>& key, std::uint64_t count)
+{
+    insertHash(hashKey(key), count);
+}
+
+void CountMinSketch::insertHash(std::uint64_t hash, std::uint64_t count)
+{
+    // Row i uses the hash h1 + i * h2 (Kirsch and Mitzenmacher)
+    const std::uint64_t h1 = hash & 0xFFFFFFFF;
+    const std::uint64_t h2 = (hash >> 32) | 1;
+
+    for (std::size_t row = 0; row < _depth; ++row)
+        _counters[row * _width + ((h1 + row * h2) & (_width - 1))] += count;
+
+    _total += count;
+}
+
+std::uint64_t CountMinSketch::estimate(const ConstContiguousView<char>& key) const
+{
+    return estimateHash(hashKey(key));
+}
+
+std::uint64_t CountMinSketch::estimateHash(std::uint64_t hash) const
+{
+    const std::uint64_t h1 = hash & 0xFFFFFFFF;
+    const std::uint64_t h2 = (hash >> 32) | 1;
+    std::uint64_t estimate = _counters[h1 & (_width - 1)];
+
+    for (std::size_t row = 1; row < _depth; ++row)
+        estimate = std::min(estimate, _counters[row * _width + ((h1 + row * h2) & (_width - 1))]);
+
+    return estimate;
+}
+
+std::uint64_t CountMinSketch::total() const
+{
+    return _total;
+}
+
+bool CountMinSketch::merge(const CountMinSketch& other)
+{
+    if (_width != other._width || _depth != other._depth)
+        return false;
+
+    for (std::size_t i = 0; i < _counters.size(); ++i)
+        _counters[i] += other._counters[i];
+
+    _total += other._total;
+    return true;
+}
+
+std::size_t CountMinSketch::serialize(std::vector<char>& bytes) const
+{
+    const std::size_t before = bytes.size();
+    const std::uint32_t depth = static_cast<std::uint32_t>(_depth);
+    const std::uint64_t width = _width;
+
+    append(bytes, CountMinSketchTag, sizeof(CountMinSketchTag));
+    append(bytes, &depth, sizeof(depth));
+    append(bytes, &width, sizeof(width));
+    append(bytes, &_total, sizeof(_total));
+    append(bytes, _counters.data(), _counters.size() * sizeof(std::uint64_t));
+
+    return bytes.size() - before;
+}
+
+bool CountMinSketch::deserialize(const ConstContiguousView<char>& bytes)
+{
+    std::size_t offset = 0;
+    std::uint32_t depth;
+    std::uint64_t width;
+    std::uint64_t total;
+
+    if (!readTag(bytes, offset, CountMinSketchTag) || !read(bytes, offset, &depth, sizeof(depth)) ||
+        !read(bytes, offset, &width, sizeof(width)) || !read(bytes, offset, &total, sizeof(total)) ||
+        depth == 0 || width == 0 || (width & (width - 1)) != 0 ||
+        (bytes.size() - offset) / sizeof(std::uint64_t) / depth != width ||
+        (bytes.size() - offset) % (sizeof(std::uint64_t) * depth) != 0)
+    {
+        return false;
+    }
+
+    CountMinSketch sketch(static_cast<std::size_t>(width), depth);
+    read(bytes, offset, sketch._counters.data(), sketch._counters.size() * sizeof(std::uint64_t));
+    sketch._total = total;
+
+    *this = std::move(sketch);
+    return true;
+}
+
+std::size_t CountMinSketch::width() const
+{
+    return _width;
+}
+
+std::size_t CountMinSketch::depth() const
+{
+    return _depth;
+}
+
+} // namespace containers
+} // namespace cmm
@@ -0,0 +1,266 @@
+#include <siminusminus/containers/stringsink.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace cmm {
+namespace containers {
+
+namespace {
+
+/**
+ * Returns the most buffers a writev() call accepts.
+ */
+std::size_t maxChunks()
+{
+#ifdef IOV_MAX
+    return IOV_MAX;
+#else
+    // Without a limit, fall back to _XOPEN_IOV_MAX, the minimum guaranteed by POSIX
+    const long limit = ::sysconf(_SC_IOV_MAX);
+    return limit > 0 ? static_cast<std::size_t>(limit) : 16;
+#endif
+}
+
+// Buffers in a batch and passed to each writev() call
+const std::size_t MaxChunks = maxChunks();
+
+// Full batches the flusher thread may have pending before the writer waits
+const std::size_t MaxQueuedBatches = 4;
+
+} // namespace
+
+/**
+ * Buffers written together.
+ */
+struct StringSink::Batch
+{
+    explicit Batch(std::size_t stagingSize)
+    {
+        staging.reserve(stagingSize);
+    }
+
+    void clear()
+    {
+        chunks.clear();
+        staging.clear();
+        owned.clear();
+        stagedLast = false;
+    }
+
+    bool empty() const
+    {
+        return chunks.empty();
+    }
+
+    std::vector<iovec> chunks;           // Buffers to write, in order
+    std::vector<char> staging;           // Copied short strings. Never grows past its capacity
+    std::vector<InmutableString> owned;  // Strings kept until written
+    bool stagedLast = false;             // True if the last chunk ends at the end of staging
+};
+
+//////////////
+// StringSink
+//////////////
+
+const std::size_t StringSink::DefaultStagingSize;
+const std::size_t StringSink::DefaultCoalesceLimit;
+
+StringSink::StringSink(int fd, Mode mode, std::size_t stagingSize, std::size_t coalesceLimit):
+    _fd(fd),
+    _mode(mode),
+    _stagingSize(stagingSize),
+    _coalesceLimit(std::min(coalesceLimit, stagingSize)),
+    _current(new Batch(stagingSize)),
+    _bytesWritten(0),
+    _error(0),
+    _busy(false),
+    _stopping(false)
+{
+    if (_mode == Mode::Background)
+        _flusher = std::thread(&StringSink::flushBatches, this);
+}
+
+StringSink::~StringSink()
+{
+    flush();
+
+    if (_flusher.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+
+        _changed.notify_all();
+        _flusher.join();
+    }
+}
+
+void StringSink::write(const ConstContiguousView<char>& view)
+{
+    const std::size_t length = view.size();
+
+    if (length == 0)
+        return;
+
+    if (length <= _coalesceLimit)
+    {
+        if (_current->staging.size() + length > _stagingSize)
+            submit();
+
+        Batch& batch = *_current;
+        char* staged = batch.staging.data() + batch.staging.size();
+        batch.staging.insert(batch.staging.end(), view.data(), view.data() + length);
+
+        if (batch.stagedLast)
+            batch.chunks.back().iov_len += length;
+        else
+            batch.chunks.push_back(iovec{staged, length});
+
+        batch.stagedLast = true;
+    }
+    else
+    {
+        _current->chunks.push_back(iovec{const_cast<char*>(view.data()), length});
+        _current->stagedLast = false;
+    }
+
+    if (_current->chunks.size() >= MaxChunks)
+        submit();
+}
+
+void StringSink::write(InmutableString&& str)
+{
+    if (str.length() <= _coalesceLimit)
+    {
+        write(str.view());
+        return;
+    }
+
+    // Moving the string does not move its characters, so the chunk stays valid
+    _current->owned.push_back(std::move(str));
+    write(_current->owned.back().view());
+}
+
+bool StringSink::flush()
+{
+    if (!_current->empty())
+        submit();
+
+    if (_mode == Mode::Background)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _changed.wait(lock, [this] { return _full.empty() && !_busy; });
+    }
+
+    return _error == 0;
+}
+
+std::size_t StringSink::bytesWritten() const
+{
+    return _bytesWritten;
+}
+
+int StringSink::error() const
+{
+    return _error;
+}
+
+void StringSink::submit()
+{
+    if (_mode == Mode::Synchronous)
+    {
+        writeBatch(*_current);
+        _current->clear();
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _changed.wait(lock, [this] { return _full.size() < MaxQueuedBatches; });
+    _full.push_back(std::move(_current));
+
+    if (_spare.empty())
+    {
+        _current.reset(new Batch(_stagingSize));
+    }
+    else
+    {
+        _current = std::move(_spare.back());
+        _spare.pop_back();
+    }
+
+    lock.unlock();
+    _changed.notify_all();
+}
+
+void StringSink::writeBatch(Batch& batch)
+{
+    iovec* chunk = batch.chunks.data();
+    std::size_t remaining = batch.chunks.size();
+
+    while (remaining > 0 && _error == 0)
+    {
+        const ssize_t written = ::writev(_fd, chunk, static_cast<int>(std::min(remaining, MaxChunks)));
+
+        if (written < 0)
+        {
+            if (errno != EINTR)
+                _error = errno;
+
+            continue;
+        }
+
+        // No buffer is empty, so writing nothing means no progress will ever be made
+        if (written == 0)
+        {
+            _error = EIO;
+            break;
+        }
+
+        _bytesWritten += static_cast<std::size_t>(written);
+
+        // Skip the buffers written and cut the one written partially
+        std::size_t left = static_cast<std::size_t>(written);
+
+        for (; remaining > 0 && left >= chunk->iov_len; ++chunk, --remaining)
+            left -= chunk->iov_len;
+
+        if (left > 0)
+        {
+            chunk->iov_base = static_cast<char*>(chunk->iov_base) + left;
+            chunk->iov_len -= left;
+        }
+    }
+}
+
+void StringSink::flushBatches()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (true)
+    {
+        _changed.wait(lock, [this] { return !_full.empty() || _stopping; });
+
+        if (_full.empty())
+            return;
+
+        std::unique_ptr<Batch> batch = std::move(_full.front());
+        _full.pop_front();
+        _busy = true;
+
+        lock.unlock();
+        writeBatch(*batch);
+        batch->clear();
+        lock.lock();
+
+        _spare.push_back(std::move(batch));
+        _busy = false;
+        _changed.notify_all();
+    }
+}
+
+} // namespace containers
+} // namespace cmm
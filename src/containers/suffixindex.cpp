@@ -0,0 +1,498 @@
+#include <siminusminus/containers/suffixindex.hpp>
+#include <siminusminus/containers/stringsink.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cmm {
+namespace containers {
+
+namespace {
+
+// Unused entry of the suffix array during SA-IS
+const std::uint64_t Empty = ~std::uint64_t(0);
+
+// Index files start with these bytes, followed by the length of the text. Then come
+// the text, padded to 8 bytes, the suffix array and the LCP array, in native byte order
+const char Magic[8] = {'C', 'M', 'M', 'S', 'U', 'F', 'X', '1'};
+const std::size_t HeaderSize = 16;
+
+// Smallest range of the LCP construction given to a thread
+const std::size_t MinChunkSize = 1 << 16;
+
+std::size_t padded(std::size_t length)
+{
+    return (length + 7) & ~std::size_t(7);
+}
+
+ConstContiguousView<char> bytesOf(const void* data, std::size_t size)
+{
+    const char* begin = static_cast<const char*>(data);
+    return ConstContiguousView<char>(begin, begin + size);
+}
+
+/**
+ * Returns true if the suffix array and the LCP array that follows it only hold offsets
+ * inside a text of the given length, so the queries never read outside the mapping.
+ */
+bool validEntries(const std::uint64_t* suffixes, std::uint64_t length)
+{
+    const std::uint64_t* const lcp = suffixes + length;
+
+    for (std::uint64_t i = 0; i < length; ++i)
+        if (suffixes[i] >= length || lcp[i] > length)
+            return false;
+
+    return true;
+}
+
+/**
+ * Suffix array by induced sorting (SA-IS, Nong, Zhang and Chan). Symbols of s are in
+ * [0, upper]. The suffixes of the reduced string of LMS substrings are sorted recursively.
+ */
+template <typename Symbol>
+void sortSuffixes(const Symbol* s, std::size_t n, std::size_t upper, std::uint64_t* sa)
+{
+    if (n == 0)
+        return;
+
+    if (n == 1)
+    {
+        sa[0] = 0;
+        return;
+    }
+
+    if (n == 2)
+    {
+        sa[0] = s[0] < s[1] ? 0 : 1;
+        sa[1] = 1 - sa[0];
+        return;
+    }
+
+    // S-type suffixes are smaller than the next one. The last suffix is L-type
+    std::vector<bool> stype(n, false);
+
+    for (std::size_t i = n - 1; i-- > 0;)
+        stype[i] = s[i] == s[i + 1] ? stype[i + 1] : s[i] < s[i + 1];
+
+    // Start of the L-type and S-type parts of the bucket of each symbol
+    std::vector<std::uint64_t> lstart(upper + 1, 0);
+    std::vector<std::uint64_t> sstart(upper + 1, 0);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (stype[i])
+            ++lstart[s[i] + 1];
+        else
+            ++sstart[s[i]];
+    }
+
+    for (std::size_t c = 0; c <= upper; ++c)
+    {
+        sstart[c] += lstart[c];
+
+        if (c < upper)
+            lstart[c + 1] += sstart[c];
+    }
+
+    std::vector<std::uint64_t> buckets(upper + 1);
+
+    const auto induce = [&](const std::vector<std::uint64_t>& lms)
+    {
+        std::fill(sa, sa + n, Empty);
+        std::copy(sstart.begin(), sstart.end(), buckets.begin());
+
+        for (std::uint64_t position : lms)
+            sa[buckets[s[position]]++] = position;
+
+        std::copy(lstart.begin(), lstart.end(), buckets.begin());
+        sa[buckets[s[n - 1]]++] = n - 1;
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::uint64_t position = sa[i];
+
+            if (position != Empty && position >= 1 && !stype[position - 1])
+                sa[buckets[s[position - 1]]++] = position - 1;
+        }
+
+        std::copy(lstart.begin(), lstart.end(), buckets.begin());
+
+        for (std::size_t i = n; i-- > 0;)
+        {
+            const std::uint64_t position = sa[i];
+
+            if (position != Empty && position >= 1 && stype[position - 1])
+                sa[--buckets[s[position - 1] + 1]] = position - 1;
+        }
+    };
+
+    // Leftmost S-type positions, and their index among them
+    std::vector<std::uint64_t> lmsIndex(n, Empty);
+    std::vector<std::uint64_t> lms;
+
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        if (!stype[i - 1] && stype[i])
+        {
+            lmsIndex[i] = lms.size();
+            lms.push_back(i);
+        }
+    }
+
+    induce(lms);
+
+    if (lms.empty())
+        return;
+
+    const std::size_t m = lms.size();
+    std::vector<std::uint64_t> sortedLms;
+    sortedLms.reserve(m);
+
+    for (std::size_t i = 0; i < n; ++i)
+        if (lmsIndex[sa[i]] != Empty)
+            sortedLms.push_back(sa[i]);
+
+    // Name the LMS substrings. Equal substrings get the same name
+    std::vector<std::uint64_t> reduced(m);
+    std::uint64_t names = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+
+    for (std::size_t i = 1; i < m; ++i)
+    {
+        std::uint64_t l = sortedLms[i - 1];
+        std::uint64_t r = sortedLms[i];
+        const std::uint64_t endL = lmsIndex[l] + 1 < m ? lms[lmsIndex[l] + 1] : n;
+        const std::uint64_t endR = lmsIndex[r] + 1 < m ? lms[lmsIndex[r] + 1] : n;
+        bool same = endL - l == endR - r;
+
+        if (same)
+        {
+            while (l < endL && s[l] == s[r])
+            {
+                ++l;
+                ++r;
+            }
+
+            same = l != n && s[l] == s[r];
+        }
+
+        if (!same)
+            ++names;
+
+        reduced[lmsIndex[sortedLms[i]]] = names;
+    }
+
+    std::vector<std::uint64_t> reducedSa(m);
+    sortSuffixes(reduced.data(), m, names, reducedSa.data());
+
+    for (std::size_t i = 0; i < m; ++i)
+        sortedLms[i] = lms[reducedSa[i]];
+
+    induce(sortedLms);
+}
+
+/**
+ * Calls body(begin, end) for consecutive ranges covering [0, n), on the pool if any.
+ */
+void forEachRange(utils::ThreadPool* pool, std::size_t n, const std::function<void(std::size_t, std::size_t)>& body)
+{
+    const std::size_t ranges = pool == nullptr ? 1 : std::max<std::size_t>(1, std::min(4 * pool->size(), n / MinChunkSize));
+
+    if (ranges == 1)
+    {
+        body(0, n);
+        return;
+    }
+
+    pool->parallelFor(ranges, [&](std::size_t range)
+    {
+        body(n * range / ranges, n * (range + 1) / ranges);
+    });
+}
+
+/**
+ * LCP array by Kasai's algorithm, over text positions instead of suffix array ranks
+ * (Kärkkäinen, Manzini and Puglisi). Ranges of positions are processed in parallel,
+ * each one starting with a zero common prefix.
+ */
+void computeLcp(const unsigned char* text, std::size_t n, const std::uint64_t* sa, std::uint64_t* lcp, utils::ThreadPool* pool)
+{
+    // Previous suffix in the suffix array of each position, then common prefix with it
+    std::vector<std::uint64_t> plcp(n);
+
+    forEachRange(pool, n, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            plcp[sa[i]] = i == 0 ? Empty : sa[i - 1];
+    });
+
+    forEachRange(pool, n, [&](std::size_t begin, std::size_t end)
+    {
+        std::size_t h = 0;
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const std::uint64_t previous = plcp[i];
+
+            if (previous == Empty)
+            {
+                plcp[i] = h = 0;
+                continue;
+            }
+
+            while (i + h < n && previous + h < n && text[i + h] == text[previous + h])
+                ++h;
+
+            plcp[i] = h;
+
+            if (h > 0)
+                --h;
+        }
+    });
+
+    forEachRange(pool, n, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+            lcp[i] = plcp[sa[i]];
+    });
+}
+
+} // namespace
+
+///////////////
+// SuffixIndex
+///////////////
+
+const std::size_t SuffixIndex::NotFound;
+
+SuffixIndex::SuffixIndex():
+    _text(nullptr),
+    _length(0),
+    _suffixes(nullptr),
+    _lcp(nullptr),
+    _mapping(nullptr),
+    _mappingSize(0)
+{
+}
+
+SuffixIndex::SuffixIndex(const ConstContiguousView<char>& text):
+    SuffixIndex()
+{
+    _text = text.data();
+    _length = text.size();
+    build(nullptr);
+}
+
+SuffixIndex::SuffixIndex(const ConstContiguousView<char>& text, utils::ThreadPool& pool):
+    SuffixIndex()
+{
+    _text = text.data();
+    _length = text.size();
+    build(&pool);
+}
+
+SuffixIndex::~SuffixIndex()
+{
+    reset();
+}
+
+bool SuffixIndex::save(const char* path) const
+{
+    const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+        return false;
+
+    const std::uint64_t length = _length;
+    const char padding[8] = {};
+    bool written;
+
+    {
+        StringSink sink(fd);
+
+        sink.write(bytesOf(Magic, sizeof(Magic)));
+        sink.write(bytesOf(&length, sizeof(length)));
+        sink.write(bytesOf(_text, _length));
+        sink.write(bytesOf(padding, padded(_length) - _length));
+        sink.write(bytesOf(_suffixes, _length * sizeof(std::uint64_t)));
+        sink.write(bytesOf(_lcp, _length * sizeof(std::uint64_t)));
+
+        written = sink.flush();
+    }
+
+    return ::close(fd) == 0 && written;
+}
+
+bool SuffixIndex::open(const char* path)
+{
+    reset();
+
+    const int fd = ::open(path, O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < HeaderSize)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    const char* bytes = static_cast<const char*>(mapping);
+    std::uint64_t length;
+    std::memcpy(&length, bytes + sizeof(Magic), sizeof(length));
+
+    // Each character takes two array entries, so a valid length is below size / 16
+    if (std::memcmp(bytes, Magic, sizeof(Magic)) != 0 || length > size / 16 ||
+        size != HeaderSize + padded(length) + 2 * length * sizeof(std::uint64_t) ||
+        !validEntries(reinterpret_cast<const std::uint64_t*>(bytes + HeaderSize + padded(length)), length))
+    {
+        ::munmap(mapping, size);
+        return false;
+    }
+
+    _mapping = mapping;
+    _mappingSize = size;
+    _text = bytes + HeaderSize;
+    _length = static_cast<std::size_t>(length);
+    _suffixes = reinterpret_cast<const std::uint64_t*>(bytes + HeaderSize + padded(_length));
+    _lcp = _suffixes + _length;
+
+    return true;
+}
+
+std::size_t SuffixIndex::count(const ConstContiguousView<char>& pattern) const
+{
+    const SuffixRange suffixes = range(pattern);
+    return suffixes.end - suffixes.begin;
+}
+
+std::size_t SuffixIndex::locate(const ConstContiguousView<char>& pattern) const
+{
+    const SuffixRange suffixes = range(pattern);
+    return suffixes.begin < suffixes.end ? static_cast<std::size_t>(_suffixes[suffixes.begin]) : NotFound;
+}
+
+std::size_t SuffixIndex::findAll(const ConstContiguousView<char>& pattern, std::vector<std::size_t>& offsets) const
+{
+    const SuffixRange suffixes = range(pattern);
+    const std::size_t before = offsets.size();
+
+    offsets.insert(offsets.end(), _suffixes + suffixes.begin, _suffixes + suffixes.end);
+    std::sort(offsets.begin() + before, offsets.end());
+
+    return suffixes.end - suffixes.begin;
+}
+
+SuffixRange SuffixIndex::range(const ConstContiguousView<char>& pattern) const
+{
+    // First suffix not less than the pattern
+    std::size_t begin = 0;
+    std::size_t end = _length;
+
+    while (begin < end)
+    {
+        const std::size_t middle = begin + (end - begin) / 2;
+
+        if (compare(_suffixes[middle], pattern) < 0)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+
+    // First suffix greater than the pattern and not starting with it
+    std::size_t last = begin;
+    end = _length;
+
+    while (last < end)
+    {
+        const std::size_t middle = last + (end - last) / 2;
+
+        if (compare(_suffixes[middle], pattern) <= 0)
+            last = middle + 1;
+        else
+            end = middle;
+    }
+
+    return SuffixRange{begin, last};
+}
+
+std::size_t SuffixIndex::suffix(std::size_t i) const
+{
+    return static_cast<std::size_t>(_suffixes[i]);
+}
+
+std::size_t SuffixIndex::lcp(std::size_t i) const
+{
+    return static_cast<std::size_t>(_lcp[i]);
+}
+
+ConstContiguousView<char> SuffixIndex::text() const
+{
+    return ConstContiguousView<char>(_text, _text + _length);
+}
+
+std::size_t SuffixIndex::length() const
+{
+    return _length;
+}
+
+void SuffixIndex::build(utils::ThreadPool* pool)
+{
+    const unsigned char* text = reinterpret_cast<const unsigned char*>(_text);
+
+    _builtSuffixes.resize(_length);
+    _builtLcp.resize(_length);
+
+    sortSuffixes(text, _length, 255, _builtSuffixes.data());
+    computeLcp(text, _length, _builtSuffixes.data(), _builtLcp.data(), pool);
+
+    _suffixes = _builtSuffixes.data();
+    _lcp = _builtLcp.data();
+}
+
+void SuffixIndex::reset()
+{
+    if (_mapping != nullptr)
+        ::munmap(_mapping, _mappingSize);
+
+    _text = nullptr;
+    _length = 0;
+    _suffixes = nullptr;
+    _lcp = nullptr;
+    _builtSuffixes.clear();
+    _builtSuffixes.shrink_to_fit();
+    _builtLcp.clear();
+    _builtLcp.shrink_to_fit();
+    _mapping = nullptr;
+    _mappingSize = 0;
+}
+
+int SuffixIndex::compare(std::size_t offset, const ConstContiguousView<char>& pattern) const
+{
+    const std::size_t available = _length - offset;
+    const std::size_t compared = std::min(available, pattern.size());
+    const int result = compared == 0 ? 0 : std::memcmp(_text + offset, pattern.data(), compared);
+
+    if (result != 0)
+        return result;
+
+    return compared < pattern.size() ? -1 : 0;
+}
+
+} // namespace containers
+} // namespace cmm
@@ -0,0 +1,188 @@
+#include <siminusminus/utils/threadpool.hpp>
+#include <algorithm>
+
+namespace cmm {
+namespace utils {
+
+namespace {
+
+// Pool and index of the worker running on this thread, if any
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+} // namespace
+
+//////////////
+// ThreadPool
+//////////////
+
+ThreadPool::ThreadPool(std::size_t threads):
+    _pending(0),
+    _nextQueue(0),
+    _stopping(false)
+{
+    for (std::size_t i = 0; i < threads; ++i)
+        _queues.emplace_back(new Queue());
+
+    for (std::size_t i = 0; i < threads; ++i)
+        _threads.emplace_back(&ThreadPool::work, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+
+    _wakeUp.notify_all();
+
+    for (std::thread& thread : _threads)
+        thread.join();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    if (_queues.empty()) // No workers, run it here
+    {
+        task();
+        return;
+    }
+
+    const std::size_t index = currentPool == this ? currentWorker
+                                                  : _nextQueue.fetch_add(1) % _queues.size();
+
+    {
+        // Counted before being queued so _pending never goes below the real count.
+        // Taking the lock avoids missing the wake up of a worker going to sleep
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_pending;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->tasks.push_back(std::move(task));
+    }
+
+    _wakeUp.notify_one();
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body)
+{
+    struct State
+    {
+        std::atomic<std::size_t> next{0};
+        std::atomic<std::size_t> done{0};
+        std::size_t count;
+        const std::function<void(std::size_t)>* body;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    if (count == 0)
+        return;
+
+    // Helpers may start after the loop finished, so the state is shared with them
+    auto state = std::make_shared<State>();
+    state->count = count;
+    state->body = &body;
+
+    auto run = [state]()
+    {
+        std::size_t i;
+
+        while ((i = state->next.fetch_add(1)) < state->count)
+        {
+            (*state->body)(i);
+
+            if (state->done.fetch_add(1) + 1 == state->count)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    const std::size_t helpers = std::min(count - 1, _threads.size());
+
+    for (std::size_t i = 0; i < helpers; ++i)
+        submit(run);
+
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state]()
+    {
+        return state->done.load() == state->count;
+    });
+}
+
+std::size_t ThreadPool::size() const
+{
+    return _threads.size();
+}
+
+std::size_t ThreadPool::defaultThreadCount()
+{
+    const std::size_t threads = std::thread::hardware_concurrency();
+    return threads != 0 ? threads : 1;
+}
+
+void ThreadPool::work(std::size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    std::function<void()> task;
+
+    while (true)
+    {
+        if (take(index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _wakeUp.wait(lock, [this]()
+        {
+            return _pending.load() != 0 || _stopping;
+        });
+
+        if (_stopping && _pending.load() == 0)
+            return;
+    }
+}
+
+bool ThreadPool::take(std::size_t index, std::function<void()>& task)
+{
+    for (std::size_t i = 0; i < _queues.size(); ++i)
+    {
+        const bool own = i == 0;
+        Queue& queue = *_queues[(index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tasks.empty())
+        {
+            if (own) // LIFO on our own queue, FIFO when stealing
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+
+            --_pending;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace utils
+} // namespace cmm
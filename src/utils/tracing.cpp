@@ -0,0 +1,286 @@
+#include <siminusminus/utils/tracing.hpp>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace cmm {
+namespace utils {
+
+namespace {
+
+enum class EventKind
+{
+    Span,
+    Counter
+};
+
+struct Event
+{
+    const char* name;        // Name given by the user
+    EventKind kind;          // Span or counter
+    std::uint64_t timestamp; // Begin of the span or time of the counter
+    std::int64_t value;      // Duration of the span or value of the counter
+};
+
+/**
+ * Events recorded by one thread. Only the owner thread writes, and it publishes each
+ * event by incrementing size.
+ */
+struct ThreadBuffer
+{
+    explicit ThreadBuffer(std::size_t id):
+        id(id),
+        events(new Event[Tracer::EventsPerThread]),
+        size(0),
+        trace(0)
+    {
+    }
+
+    std::size_t id;                   // Thread id in the exported trace
+    std::unique_ptr<Event[]> events;  // Recorded events
+    std::atomic<std::size_t> size;    // Number of published events
+    std::atomic<std::uint64_t> trace; // Trace the events belong to
+};
+
+/**
+ * Buffers of all the threads that recorded events. Buffers are never freed, so the
+ * events of finished threads can still be exported. Instead, new threads reuse the
+ * buffers of finished ones, appending to their events.
+ */
+struct Registry
+{
+    std::mutex mutex;                                   // Guards buffers and unused
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers; // One per thread
+    std::vector<ThreadBuffer*> unused;                  // Buffers of finished threads
+    std::atomic<std::uint64_t> trace{0};                // Incremented by each start()
+    std::atomic<std::uint64_t> epoch{0};                // now() at the last start()
+    std::atomic<std::size_t> dropped{0};                // Events dropped in this trace
+};
+
+// Never destroyed, threads may record events during static destruction
+Registry& registry()
+{
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+thread_local ThreadBuffer* localBuffer = nullptr;
+thread_local bool threadExited = false;
+
+/**
+ * Returns the buffer of the thread to the registry when the thread exits.
+ */
+struct BufferOwner
+{
+    ~BufferOwner()
+    {
+        Registry& events = registry();
+        std::lock_guard<std::mutex> lock(events.mutex);
+
+        events.unused.push_back(localBuffer);
+        localBuffer = nullptr;
+        threadExited = true;
+    }
+};
+
+/**
+ * Returns the buffer of the thread, or null if the thread is exiting and already gave
+ * its buffer back.
+ */
+ThreadBuffer* threadBuffer()
+{
+    if (localBuffer == nullptr && !threadExited)
+    {
+        Registry& events = registry();
+
+        {
+            std::lock_guard<std::mutex> lock(events.mutex);
+
+            if (events.unused.empty())
+            {
+                events.buffers.emplace_back(new ThreadBuffer(events.buffers.size() + 1));
+                localBuffer = events.buffers.back().get();
+            }
+            else
+            {
+                localBuffer = events.unused.back();
+                events.unused.pop_back();
+            }
+        }
+
+        thread_local BufferOwner owner;
+        static_cast<void>(owner);
+    }
+
+    return localBuffer;
+}
+
+void record(const char* name, EventKind kind, std::uint64_t timestamp, std::int64_t value)
+{
+    ThreadBuffer* const local = threadBuffer();
+    Registry& events = registry();
+
+    if (local == nullptr)
+    {
+        events.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ThreadBuffer& buffer = *local;
+    const std::uint64_t trace = events.trace.load(std::memory_order_acquire);
+
+    // The first event of a new trace discards the events of the previous one
+    if (buffer.trace.load(std::memory_order_relaxed) != trace)
+    {
+        buffer.size.store(0, std::memory_order_relaxed);
+        buffer.trace.store(trace, std::memory_order_release);
+    }
+
+    const std::size_t size = buffer.size.load(std::memory_order_relaxed);
+
+    if (size == Tracer::EventsPerThread)
+    {
+        events.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[size] = Event{name, kind, timestamp, value};
+    buffer.size.store(size + 1, std::memory_order_release);
+}
+
+/**
+ * Writes a string as a JSON string literal.
+ */
+void writeJsonString(std::ostream& os, const char* string)
+{
+    os << '"';
+
+    for (const char* c = string; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            os << '\\' << *c;
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(*c));
+            os << escaped;
+        }
+        else
+        {
+            os << *c;
+        }
+    }
+
+    os << '"';
+}
+
+/**
+ * Writes a number of nanoseconds as microseconds, the time unit of Chrome traces.
+ */
+void writeMicroseconds(std::ostream& os, std::uint64_t nanoseconds)
+{
+    char microseconds[32];
+    std::snprintf(microseconds, sizeof(microseconds), "%llu.%03u",
+                  static_cast<unsigned long long>(nanoseconds / 1000), static_cast<unsigned int>(nanoseconds % 1000));
+    os << microseconds;
+}
+
+} // namespace
+
+//////////
+// Tracer
+//////////
+
+const std::size_t Tracer::EventsPerThread;
+
+std::atomic<bool> Tracer::_enabled(false);
+
+void Tracer::start()
+{
+    Registry& events = registry();
+
+    events.dropped.store(0, std::memory_order_relaxed);
+    events.epoch.store(now(), std::memory_order_relaxed);
+    events.trace.fetch_add(1, std::memory_order_release);
+    _enabled.store(true, std::memory_order_release);
+}
+
+void Tracer::stop()
+{
+    _enabled.store(false, std::memory_order_release);
+}
+
+void Tracer::span(const char* name, std::uint64_t begin, std::uint64_t end)
+{
+    if (enabled())
+        record(name, EventKind::Span, begin, static_cast<std::int64_t>(end - begin));
+}
+
+void Tracer::counter(const char* name, std::int64_t value)
+{
+    if (enabled())
+        record(name, EventKind::Counter, now(), value);
+}
+
+std::size_t Tracer::exportChromeTrace(std::ostream& os)
+{
+    Registry& events = registry();
+    const std::uint64_t trace = events.trace.load(std::memory_order_acquire);
+    const std::uint64_t epoch = events.epoch.load(std::memory_order_relaxed);
+    std::size_t written = 0;
+
+    std::vector<ThreadBuffer*> buffers;
+
+    {
+        std::lock_guard<std::mutex> lock(events.mutex);
+
+        for (const std::unique_ptr<ThreadBuffer>& buffer : events.buffers)
+            buffers.push_back(buffer.get());
+    }
+
+    os << "{\"traceEvents\":[";
+
+    for (const ThreadBuffer* buffer : buffers)
+    {
+        if (buffer->trace.load(std::memory_order_acquire) != trace)
+            continue;
+
+        const std::size_t size = buffer->size.load(std::memory_order_acquire);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const Event& event = buffer->events[i];
+
+            os << (written++ == 0 ? "\n" : ",\n") << "{\"name\":";
+            writeJsonString(os, event.name);
+            os << ",\"ph\":\"" << (event.kind == EventKind::Span ? 'X' : 'C') << "\",\"pid\":1,\"tid\":" << buffer->id << ",\"ts\":";
+            writeMicroseconds(os, event.timestamp > epoch ? event.timestamp - epoch : 0);
+
+            if (event.kind == EventKind::Span)
+            {
+                os << ",\"dur\":";
+                writeMicroseconds(os, static_cast<std::uint64_t>(event.value));
+            }
+            else
+            {
+                os << ",\"args\":{\"value\":" << event.value << '}';
+            }
+
+            os << '}';
+        }
+    }
+
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return written;
+}
+
+std::size_t Tracer::droppedEvents()
+{
+    return registry().dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace utils
+} // namespace cmm
@@ -0,0 +1,168 @@
+#include <siminusminus/containers/ahocorasick.hpp>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <string>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+
+//////////////////////
+// AhoCorasickMatcher
+//////////////////////
+
+namespace {
+
+/**
+ * Reference matcher, one pattern at a time, ordered like AhoCorasickMatcher
+ * reports the matches (by end of the match, then longest first).
+ */
+std::vector<std::pair<std::size_t, std::size_t>> naiveMatches(const std::vector<InmutableString>& patterns,
+                                                              const std::string& text)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> matches;
+
+    for (std::size_t end = 1; end <= text.size(); ++end)
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> endingHere;
+
+        for (std::size_t id = 0; id < patterns.size(); ++id)
+        {
+            const std::string pattern = patterns[id].toString();
+
+            if (!pattern.empty() && pattern.size() <= end &&
+                text.compare(end - pattern.size(), pattern.size(), pattern) == 0)
+            {
+                endingHere.emplace_back(id, end - pattern.size());
+            }
+        }
+
+        std::stable_sort(endingHere.begin(), endingHere.end(),
+            [](const std::pair<std::size_t, std::size_t>& lhs, const std::pair<std::size_t, std::size_t>& rhs)
+            {
+                return lhs.second < rhs.second;
+            });
+
+        matches.insert(matches.end(), endingHere.begin(), endingHere.end());
+    }
+
+    return matches;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> matcherMatches(const AhoCorasickMatcher& matcher,
+                                                                const InmutableString& text)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> matches;
+
+    matcher.scan(text.view(), [&matches](const AhoCorasickMatch& match)
+    {
+        matches.emplace_back(match.pattern, match.offset);
+    });
+
+    return matches;
+}
+
+} // namespace
+
+TEST(AhoCorasickMatcher_scan, classicExample)
+{
+    AhoCorasickMatcher matcher({"he", "she", "his", "hers"});
+    InmutableString text("ushers");
+
+    std::vector<AhoCorasickMatch> matches;
+    EXPECT_EQ(matcher.findAll(text.view(), matches), 3u);
+
+    ASSERT_EQ(matches.size(), 3u);
+    EXPECT_EQ(matches[0].pattern, 1u);
+    EXPECT_EQ(matches[0].offset, 1u);
+    EXPECT_EQ(matches[1].pattern, 0u);
+    EXPECT_EQ(matches[1].offset, 2u);
+    EXPECT_EQ(matches[2].pattern, 3u);
+    EXPECT_EQ(matches[2].offset, 2u);
+}
+
+TEST(AhoCorasickMatcher_scan, overlappingAndNestedPatterns)
+{
+    std::vector<InmutableString> patterns{"a", "aa", "aaa", "ab", "b"};
+    AhoCorasickMatcher matcher(patterns);
+    InmutableString text("aaabaab");
+
+    EXPECT_EQ(matcherMatches(matcher, text), naiveMatches(patterns, text.toString()));
+}
+
+TEST(AhoCorasickMatcher_scan, duplicateAndEmptyPatterns)
+{
+    AhoCorasickMatcher matcher({"abc", "", "abc"});
+    InmutableString text("xabcx");
+
+    std::vector<AhoCorasickMatch> matches;
+    matcher.findAll(text.view(), matches);
+
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0].pattern, 0u);
+    EXPECT_EQ(matches[1].pattern, 2u);
+    EXPECT_EQ(matcher.patternCount(), 3u);
+}
+
+TEST(AhoCorasickMatcher_scan, prefilterMatchesAcrossBlocks)
+{
+    // Few start bytes, so the SIMD prefilter is enabled
+    std::vector<InmutableString> patterns{"needle", "nest", "zz"};
+    AhoCorasickMatcher matcher(patterns);
+    InmutableString text("....................needle.......ne.st....nest.................................zzz");
+
+    EXPECT_EQ(matcherMatches(matcher, text), naiveMatches(patterns, text.toString()));
+}
+
+TEST(AhoCorasickMatcher_scan, rareBytePrefilter)
+{
+    // Too many start bytes, but every pattern contains a '_' or a '='
+    std::vector<InmutableString> patterns{"user_id=", "session_id", "request_id", "a=b", "_", "q=", "id_"};
+    AhoCorasickMatcher matcher(patterns);
+    unsigned int seed = 5;
+
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        std::string text;
+
+        for (std::size_t j = 0; j < 40 + i % 50; ++j)
+        {
+            seed = seed * 1103515245u + 12345u;
+            const std::size_t pick = (seed >> 16) % 24;
+            text += pick < patterns.size() ? patterns[pick].toString().substr(pick % 3) : std::string(1, "abdeiqrsu"[pick % 9]);
+        }
+
+        InmutableString itext(text.c_str());
+
+        EXPECT_EQ(matcherMatches(matcher, itext), naiveMatches(patterns, text)) << text;
+        EXPECT_EQ(matcher.containsAny(itext.view()), !naiveMatches(patterns, text).empty()) << text;
+    }
+}
+
+TEST(AhoCorasickMatcher_scan, manyPatterns)
+{
+    std::vector<InmutableString> patterns;
+    std::string text;
+
+    for (std::size_t i = 0; i < 200; ++i)
+        patterns.emplace_back(("key" + std::to_string(i * 7) + "#").c_str());
+
+    for (std::size_t i = 0; i < 500; ++i)
+        text += "key" + std::to_string(i) + "#-";
+
+    AhoCorasickMatcher matcher(patterns);
+    InmutableString itext(text.c_str());
+
+    EXPECT_EQ(matcherMatches(matcher, itext), naiveMatches(patterns, text));
+}
+
+TEST(AhoCorasickMatcher_containsAny, foundAndNotFound)
+{
+    AhoCorasickMatcher matcher({"foo", "bar"});
+    InmutableString yes("xxxxxxxxxxxxxxxxxxxxxxxbarxx");
+    InmutableString no("xxxxxxxxxxxxxxxxxxfoxbaxxxxx");
+    InmutableString empty;
+
+    EXPECT_TRUE(matcher.containsAny(yes.view()));
+    EXPECT_FALSE(matcher.containsAny(no.view()));
+    EXPECT_FALSE(matcher.containsAny(empty.view()));
+}
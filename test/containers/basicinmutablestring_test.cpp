@@ -0,0 +1,218 @@
+#include <siminusminus/containers/inmutablestring.hpp>
+#include <gmock/gmock.h>
+#include <sstream>
+#include <vector>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+
+////////////////////////////////////////////
+// BasicInmutableString storage policies
+////////////////////////////////////////////
+
+template <typename String>
+class BasicInmutableString_storage : public Test
+{
+public:
+
+    BasicInmutableString_storage(): _scope(_arena) {}
+
+private:
+
+    StringArena _arena;
+    StringArena::Scope _scope;
+};
+
+typedef Types<BasicInmutableString<HeapStorage, NoLogging, char>,
+              BasicInmutableString<InlineStorage, NoLogging, char>,
+              BasicInmutableString<SharedStorage, NoLogging, char>,
+              BasicInmutableString<ArenaStorage, NoLogging, char>> StoragePolicies;
+
+TYPED_TEST_CASE(BasicInmutableString_storage, StoragePolicies);
+
+TYPED_TEST(BasicInmutableString_storage, construction)
+{
+    TypeParam empty;
+    TypeParam shortString("Hello");
+    TypeParam longString("This string is too long to be stored inline");
+
+    EXPECT_EQ(empty.length(), 0u);
+    EXPECT_EQ(empty.data()[0], '\0');
+    EXPECT_EQ(shortString.length(), 5u);
+    EXPECT_EQ(shortString.toString(), "Hello");
+    EXPECT_EQ(longString.toString(), "This string is too long to be stored inline");
+    EXPECT_EQ(longString.data()[longString.length()], '\0');
+}
+
+TYPED_TEST(BasicInmutableString_storage, copyAndMove)
+{
+    for (const char* text : {"Hello", "This string is too long to be stored inline"})
+    {
+        TypeParam original(text);
+        TypeParam copy(original);
+        EXPECT_EQ(copy, original);
+
+        TypeParam moved(std::move(copy));
+        EXPECT_EQ(moved, original);
+        EXPECT_EQ(copy.length(), 0u);
+        EXPECT_EQ(copy, "");
+
+        TypeParam assigned;
+        assigned = original;
+        EXPECT_EQ(assigned, original);
+
+        TypeParam moveAssigned("previous value");
+        moveAssigned = std::move(assigned);
+        EXPECT_EQ(moveAssigned, original);
+        EXPECT_EQ(assigned.length(), 0u);
+
+        const TypeParam& self = moveAssigned;
+        moveAssigned = self;
+        EXPECT_EQ(moveAssigned, original);
+    }
+}
+
+TYPED_TEST(BasicInmutableString_storage, operations)
+{
+    TypeParam hello("Hello, ");
+    TypeParam world("World!");
+    TypeParam helloWorld = hello + world;
+
+    EXPECT_EQ(helloWorld, "Hello, World!");
+    EXPECT_LT(hello, world);
+    EXPECT_EQ(helloWorld.toUpper(), "HELLO, WORLD!");
+    EXPECT_EQ(TypeParam("  spaced   out  ").trim().collapseWhitespace(), "spaced out");
+
+    std::vector<TypeParam> strings;
+
+    for (int i = 0; i < 100; ++i)
+        strings.push_back(helloWorld);
+
+    for (const TypeParam& string : strings)
+        EXPECT_EQ(string, helloWorld);
+}
+
+////////////////////////////////////////////
+// BasicInmutableString specific behavior
+////////////////////////////////////////////
+
+TEST(BasicInmutableString_comparison, prefixesAndEmbeddedEnds)
+{
+    InmutableString abc("abc");
+    InmutableString ab("ab");
+    const char withEnd[] = {'a', '\0', 'b'};
+    InmutableString embedded(ConstContiguousView<char>(withEnd, withEnd + 3));
+    InmutableString prefix("a");
+
+    EXPECT_GT(abc, ab);
+    EXPECT_LT(ab, abc);
+    EXPECT_GE(abc, ab);
+    EXPECT_FALSE(ab >= abc);
+    EXPECT_NE(embedded, prefix);
+    EXPECT_GT(embedded, prefix);
+    EXPECT_EQ(embedded.length(), 3u);
+}
+
+TEST(BasicInmutableString_output, writesTheWholeView)
+{
+    const char withEnd[] = {'a', '\0', 'b'};
+    InmutableString embedded(ConstContiguousView<char>(withEnd, withEnd + 3));
+    std::ostringstream os;
+
+    os << embedded;
+    EXPECT_EQ(os.str(), std::string(withEnd, 3));
+}
+
+TEST(BasicInmutableString_sharedStorage, copiesShareCharacters)
+{
+    typedef BasicInmutableString<SharedStorage, NoLogging, char> SharedString;
+
+    SharedString str("shared characters");
+    EXPECT_EQ(str.storage().useCount(), 1u);
+
+    {
+        SharedString copy = str;
+        EXPECT_EQ(copy.data(), str.data());
+        EXPECT_EQ(str.storage().useCount(), 2u);
+    }
+
+    EXPECT_EQ(str.storage().useCount(), 1u);
+}
+
+TEST(BasicInmutableString_inlineStorage, shortStringsAreInline)
+{
+    typedef BasicInmutableString<InlineStorage, NoLogging, char> InlineString;
+
+    InlineString shortString("inline");
+    InlineString longString("this one lives on the heap");
+    const char* object = reinterpret_cast<const char*>(&shortString);
+
+    EXPECT_TRUE(shortString.data() >= object && shortString.data() < object + sizeof(shortString));
+    EXPECT_EQ(InlineStorage<char>::InlineCapacity, 23u);
+    EXPECT_EQ(longString, "this one lives on the heap");
+}
+
+TEST(BasicInmutableString_arenaStorage, allocatesFromTheCurrentArena)
+{
+    typedef BasicInmutableString<ArenaStorage, NoLogging, char> ArenaString;
+
+    StringArena arena(1024);
+    StringArena::Scope scope(arena);
+
+    ArenaString first("first");
+    ArenaString second = first + " and second";
+
+    EXPECT_EQ(second, "first and second");
+    EXPECT_EQ(arena.capacity(), 1024u);
+    EXPECT_EQ(&StringArena::current(), &arena);
+}
+
+TEST(BasicInmutableString_characterTypes, wideStrings)
+{
+    typedef BasicInmutableString<HeapStorage, NoLogging, char16_t> String16;
+
+    String16 str(u"Hello World");
+    EXPECT_EQ(str.length(), 11u);
+    EXPECT_TRUE(str.toLower() == String16(u"hello world"));
+    EXPECT_TRUE(str.replace(u' ', u'_') == String16(u"Hello_World"));
+}
+
+#ifdef SIMINUSMINUS_TRACING
+TEST(BasicInmutableString_tracingLogging, recordsConstructionAndConcatenation)
+{
+    typedef BasicInmutableString<HeapStorage, TracingLogging, char> TracedString;
+
+    ::cmm::utils::Tracer::start();
+
+    {
+        TracedString hello("Hello, ");
+        TracedString helloWorld = hello + TracedString("World!");
+        EXPECT_EQ(helloWorld.length(), 13u);
+    }
+
+    ::cmm::utils::Tracer::stop();
+
+    std::ostringstream os;
+    EXPECT_EQ(::cmm::utils::Tracer::exportChromeTrace(os), 3u);
+    EXPECT_THAT(os.str(), HasSubstr("\"InmutableString(const CharT*)\""));
+    EXPECT_THAT(os.str(), HasSubstr("\"InmutableString operator+\""));
+}
+#else
+TEST(BasicInmutableString_tracingLogging, compiledOutWithoutTracing)
+{
+    typedef BasicInmutableString<HeapStorage, TracingLogging, char> TracedString;
+
+    ::cmm::utils::Tracer::start();
+
+    {
+        TracedString hello("Hello, ");
+        TracedString helloWorld = hello + TracedString("World!");
+        EXPECT_EQ(helloWorld.length(), 13u);
+    }
+
+    ::cmm::utils::Tracer::stop();
+
+    std::ostringstream os;
+    EXPECT_EQ(::cmm::utils::Tracer::exportChromeTrace(os), 0u);
+}
+#endif
@@ -0,0 +1,170 @@
+#include <siminusminus/containers/editdistance.hpp>
+#include <gmock/gmock.h>
+#include <string>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+
+//////////////////
+// Edit distance
+//////////////////
+
+namespace {
+
+/**
+ * Textbook dynamic programming distance, used as reference.
+ */
+std::size_t naiveDistance(const std::string& lhs, const std::string& rhs)
+{
+    std::vector<std::size_t> row(rhs.size() + 1);
+
+    for (std::size_t j = 0; j <= rhs.size(); ++j)
+        row[j] = j;
+
+    for (std::size_t i = 1; i <= lhs.size(); ++i)
+    {
+        std::size_t diagonal = row[0];
+        row[0] = i;
+
+        for (std::size_t j = 1; j <= rhs.size(); ++j)
+        {
+            const std::size_t above = row[j];
+            row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (lhs[i - 1] != rhs[j - 1])});
+            diagonal = above;
+        }
+    }
+
+    return row[rhs.size()];
+}
+
+/**
+ * Pseudo random string over a small alphabet, so there are many partial matches.
+ */
+std::string randomString(unsigned int& seed, std::size_t length)
+{
+    std::string result(length, ' ');
+
+    for (char& c : result)
+    {
+        seed = seed * 1103515245u + 12345u;
+        c = static_cast<char>('a' + (seed >> 16) % 3);
+    }
+
+    return result;
+}
+
+std::size_t distance(const char* lhs, const char* rhs)
+{
+    InmutableString ilhs(lhs);
+    InmutableString irhs(rhs);
+
+    return editDistance(ilhs.view(), irhs.view());
+}
+
+} // namespace
+
+TEST(EditDistance_editDistance, knownDistances)
+{
+    EXPECT_EQ(distance("", ""), 0u);
+    EXPECT_EQ(distance("abc", ""), 3u);
+    EXPECT_EQ(distance("", "abc"), 3u);
+    EXPECT_EQ(distance("kitten", "sitting"), 3u);
+    EXPECT_EQ(distance("flaw", "lawn"), 2u);
+    EXPECT_EQ(distance("example.com", "example.com"), 0u);
+    EXPECT_EQ(distance("example.com", "examp1e.co"), 2u);
+}
+
+TEST(EditDistance_editDistance, matchesDynamicProgramming)
+{
+    unsigned int seed = 42;
+
+    // Lengths around the word size exercise the single and multi word paths
+    for (std::size_t lhsLength : {1u, 7u, 63u, 64u, 65u, 130u})
+    {
+        for (std::size_t rhsLength : {0u, 5u, 64u, 70u, 200u})
+        {
+            const std::string lhs = randomString(seed, lhsLength);
+            const std::string rhs = randomString(seed, rhsLength);
+            InmutableString ilhs(lhs.c_str());
+            InmutableString irhs(rhs.c_str());
+
+            EXPECT_EQ(editDistance(ilhs.view(), irhs.view()), naiveDistance(lhs, rhs)) << lhs << " " << rhs;
+        }
+    }
+}
+
+TEST(EditDistance_boundedEditDistance, stopsAtThreshold)
+{
+    unsigned int seed = 7;
+
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        const std::string lhs = randomString(seed, 10 + i % 90);
+        const std::string rhs = randomString(seed, 10 + (i * 7) % 90);
+        InmutableString ilhs(lhs.c_str());
+        InmutableString irhs(rhs.c_str());
+        const std::size_t expected = naiveDistance(lhs, rhs);
+        const std::size_t k = i % 40;
+
+        EXPECT_EQ(boundedEditDistance(ilhs.view(), irhs.view(), k), std::min(expected, k + 1));
+    }
+}
+
+TEST(EditDistance_fuzzyMatcher, findWithinMatchesScalarDistances)
+{
+    unsigned int seed = 1234;
+
+    for (std::size_t queryLength : {0u, 1u, 12u, 64u, 100u})
+    {
+        const std::string query = randomString(seed, queryLength);
+        InmutableString iquery(query.c_str());
+        FuzzyMatcher matcher(iquery.view());
+        std::vector<InmutableString> candidates;
+
+        for (std::size_t i = 0; i < 101; ++i)
+        {
+            // Mutations of the query and unrelated strings
+            std::string candidate = i % 2 ? query : randomString(seed, i % 70);
+
+            if (!candidate.empty())
+                candidate[i % candidate.size()] = 'z';
+
+            candidate += randomString(seed, i % 4);
+            candidates.emplace_back(candidate.c_str());
+        }
+
+        for (std::size_t k : {0u, 2u, 10u})
+        {
+            std::vector<FuzzyMatch> matches;
+            std::vector<std::pair<std::size_t, std::size_t>> found, expected;
+
+            matcher.findWithin(candidates, k, matches);
+
+            for (const FuzzyMatch& match : matches)
+                found.emplace_back(match.candidate, match.distance);
+
+            for (std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                const std::size_t d = naiveDistance(query, candidates[i].toString());
+
+                if (d <= k)
+                    expected.emplace_back(i, d);
+            }
+
+            EXPECT_EQ(found, expected) << "query length " << queryLength << ", k " << k;
+        }
+    }
+}
+
+TEST(EditDistance_fuzzyMatcher, reusesTheQuery)
+{
+    InmutableString query("product title");
+    InmutableString close("produkt title");
+    InmutableString far("something else entirely");
+    FuzzyMatcher matcher(query.view());
+
+    EXPECT_EQ(matcher.queryLength(), 13u);
+    EXPECT_EQ(matcher.distance(close.view()), 1u);
+    EXPECT_EQ(matcher.distance(far.view(), 3), 4u);
+    EXPECT_EQ(matcher.distance(far.view()), naiveDistance(query.toString(), far.toString()));
+}
@@ -0,0 +1,196 @@
+#include <siminusminus/containers/globmatcher.hpp>
+#include <gmock/gmock.h>
+#include <string>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+
+////////////////
+// GlobMatcher
+////////////////
+
+namespace {
+
+/**
+ * Backtracking matcher for patterns made of literals, `?` and `*`, used as reference.
+ */
+bool naiveMatch(const char* pattern, const char* text)
+{
+    if (*pattern == '\0')
+        return *text == '\0';
+
+    if (*pattern == '*')
+        return naiveMatch(pattern + 1, text) || (*text != '\0' && naiveMatch(pattern, text + 1));
+
+    return *text != '\0' && (*pattern == '?' || *pattern == *text) && naiveMatch(pattern + 1, text + 1);
+}
+
+/**
+ * Pseudo random string over the given alphabet.
+ */
+std::string randomString(unsigned int& seed, std::size_t length, const char* alphabet, std::size_t size)
+{
+    std::string result(length, ' ');
+
+    for (char& c : result)
+    {
+        seed = seed * 1103515245u + 12345u;
+        c = alphabet[(seed >> 16) % size];
+    }
+
+    return result;
+}
+
+std::vector<std::size_t> matchAll(const GlobMatcher& matcher, const char* text)
+{
+    InmutableString str(text);
+    std::vector<std::size_t> matches;
+
+    matcher.matchAll(str.view(), matches);
+    return matches;
+}
+
+} // namespace
+
+TEST(GlobMatcher_matchAll, reportsEveryMatchingPattern)
+{
+    GlobMatcher matcher({"api/*", "*.json", "img/[0-9]?.png", "api/v?/users/*.json", "exact", "*"});
+
+    EXPECT_EQ(matcher.patternCount(), 6u);
+    EXPECT_THAT(matchAll(matcher, "api/v1/users/42.json"), ElementsAre(0, 1, 3, 5));
+    EXPECT_THAT(matchAll(matcher, "img/42.png"), ElementsAre(2, 5));
+    EXPECT_THAT(matchAll(matcher, "img/a2.png"), ElementsAre(5));
+    EXPECT_THAT(matchAll(matcher, "exact"), ElementsAre(4, 5));
+    EXPECT_THAT(matchAll(matcher, ""), ElementsAre(5));
+}
+
+TEST(GlobMatcher_matchAll, bracketExpressions)
+{
+    GlobMatcher matcher({"[a-c]x", "[!a-c]x", "[]]", "[^]]", "a\\*", "[a\\-z]", "[unclosed"});
+
+    EXPECT_THAT(matchAll(matcher, "bx"), ElementsAre(0));
+    EXPECT_THAT(matchAll(matcher, "dx"), ElementsAre(1));
+    EXPECT_THAT(matchAll(matcher, "]"), ElementsAre(2));
+    EXPECT_THAT(matchAll(matcher, "q"), ElementsAre(3));
+    EXPECT_THAT(matchAll(matcher, "a*"), ElementsAre(4));
+    EXPECT_THAT(matchAll(matcher, "ab"), ElementsAre());
+    EXPECT_THAT(matchAll(matcher, "-"), ElementsAre(3, 5));
+    EXPECT_THAT(matchAll(matcher, "[unclosed"), ElementsAre(6));
+}
+
+TEST(GlobMatcher_matchAll, unclosedBracketIsOnlyALiteral)
+{
+    GlobMatcher matcher({"a[bc", "x[y?"});
+
+    EXPECT_THAT(matchAll(matcher, "a[bc"), ElementsAre(0));
+    EXPECT_THAT(matchAll(matcher, "abbc"), ElementsAre());
+    EXPECT_THAT(matchAll(matcher, "acbc"), ElementsAre());
+    EXPECT_THAT(matchAll(matcher, "x[yz"), ElementsAre(1));
+    EXPECT_THAT(matchAll(matcher, "xyyz"), ElementsAre());
+}
+
+TEST(GlobMatcher_matchAll, matchesBacktracking)
+{
+    unsigned int seed = 99;
+    std::vector<std::string> patterns;
+    std::vector<InmutableString> compiled;
+
+    for (std::size_t i = 0; i < 40; ++i)
+    {
+        patterns.push_back(randomString(seed, 1 + i % 7, "ab?*", 4));
+        compiled.emplace_back(patterns.back().c_str());
+    }
+
+    GlobMatcher matcher(compiled);
+
+    for (std::size_t i = 0; i < 500; ++i)
+    {
+        const std::string text = randomString(seed, i % 12, "abc", 3);
+        std::vector<std::size_t> expected;
+
+        for (std::size_t p = 0; p < patterns.size(); ++p)
+            if (naiveMatch(patterns[p].c_str(), text.c_str()))
+                expected.push_back(p);
+
+        EXPECT_EQ(matchAll(matcher, text.c_str()), expected) << text;
+    }
+}
+
+TEST(GlobMatcher_matchAll, capsTheStatesBuilt)
+{
+    // "*a" followed by n `?` needs 2^(n + 1) + 1 states
+    const std::vector<std::string> patterns = {"*a" + std::string(20, '?'), "b*a??"};
+    GlobMatcher matcher({InmutableString(patterns[0].c_str()), InmutableString(patterns[1].c_str())});
+    unsigned int seed = 7;
+
+    EXPECT_LE(matcher.stateCount(), GlobMatcher::MaxStates);
+
+    for (std::size_t i = 0; i < 300; ++i)
+    {
+        const std::string text = randomString(seed, 15 + i % 30, "ab", 2);
+        std::vector<std::size_t> expected;
+
+        for (std::size_t p = 0; p < patterns.size(); ++p)
+            if (naiveMatch(patterns[p].c_str(), text.c_str()))
+                expected.push_back(p);
+
+        EXPECT_EQ(matchAll(matcher, text.c_str()), expected) << text;
+        EXPECT_EQ(matcher.matchesAny(InmutableString(text.c_str()).view()), !expected.empty()) << text;
+    }
+}
+
+TEST(GlobMatcher_literals, manyLiteralPatterns)
+{
+    std::vector<InmutableString> patterns;
+
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        const std::string number = std::to_string(i);
+
+        patterns.emplace_back(("file" + number).c_str());
+        patterns.emplace_back(("dir" + number + "/*").c_str());
+        patterns.emplace_back(("*." + number).c_str());
+    }
+
+    GlobMatcher matcher(patterns);
+
+    EXPECT_EQ(matcher.stateCount(), 0u);
+    EXPECT_THAT(matchAll(matcher, "file42"), ElementsAre(126));
+    EXPECT_THAT(matchAll(matcher, "file4"), ElementsAre(12));
+    EXPECT_THAT(matchAll(matcher, "dir7/file42"), ElementsAre(22));
+    EXPECT_THAT(matchAll(matcher, "dir7/archive.42"), ElementsAre(22, 128));
+    EXPECT_THAT(matchAll(matcher, "dir7"), ElementsAre());
+    EXPECT_THAT(matchAll(matcher, "file42.999"), ElementsAre(2999));
+}
+
+TEST(GlobMatcher_literals, doNotNeedTheAutomaton)
+{
+    GlobMatcher literals({"index.html", "static/*", "*.css", "\\*star"});
+    InmutableString style("static/main.css");
+    InmutableString star("*star");
+    InmutableString other("favicon.ico");
+
+    EXPECT_EQ(literals.stateCount(), 0u);
+    EXPECT_THAT(matchAll(literals, "static/main.css"), ElementsAre(1, 2));
+    EXPECT_TRUE(literals.matchesAny(star.view()));
+    EXPECT_FALSE(literals.matchesAny(other.view()));
+
+    GlobMatcher general({"*.c*"});
+    EXPECT_GT(general.stateCount(), 0u);
+    EXPECT_TRUE(general.matchesAny(style.view()));
+    EXPECT_FALSE(general.matchesAny(other.view()));
+}
+
+TEST(GlobMatcher_match, viewsNeedNotBeTerminated)
+{
+    GlobMatcher matcher({"ab*", "a?c", "*c"});
+    const char text[] = {'a', 'b', 'c', 'd'};
+    std::size_t calls = 0;
+
+    matcher.match(ConstContiguousView<char>(text, text + 3), [&calls](std::size_t)
+    {
+        ++calls;
+    });
+
+    EXPECT_EQ(calls, 3u);
+}
@@ -266,4 +266,76 @@ TEST(ConstContiguousIterator_operators, equalOrNotEqual)
 
     ++istringit2;
     EXPECT_EQ(*istringit1, *istringit2);
-}
\ No newline at end of file
+}
+
+////////////////////////////////
+// InmutableString transforms
+////////////////////////////////
+
+TEST(InmutableString_transforms, constructFromView)
+{
+    InmutableString str("Hello World");
+    InmutableString hello(ConstContiguousView<char>(&str[0], &str[5]));
+    EXPECT_EQ(hello, "Hello");
+    EXPECT_EQ(hello.length(), 5u);
+}
+
+TEST(InmutableString_transforms, toLowerAndToUpper)
+{
+    InmutableString str("Hello, World! The QUICK brown fox @[`{ 0123456789 Zz");
+    EXPECT_EQ(str.toLower(), "hello, world! the quick brown fox @[`{ 0123456789 zz");
+    EXPECT_EQ(str.toUpper(), "HELLO, WORLD! THE QUICK BROWN FOX @[`{ 0123456789 ZZ");
+    EXPECT_EQ(str.toLower().length(), str.length());
+}
+
+TEST(InmutableString_transforms, toLowerKeepsNonAscii)
+{
+    InmutableString str("\xC3\x89T\xC3\x89 \xC3\x89T\xC3\x89 \xC3\x89T\xC3\x89");
+    EXPECT_EQ(str.toLower(), "\xC3\x89t\xC3\x89 \xC3\x89t\xC3\x89 \xC3\x89t\xC3\x89");
+}
+
+TEST(InmutableString_transforms, trim)
+{
+    InmutableString str(" \t\n Hello World \r\n");
+    InmutableString spaces("   ");
+    EXPECT_EQ(str.trim(), "Hello World");
+    EXPECT_EQ(spaces.trim(), "");
+    EXPECT_EQ(InmutableString().trim(), "");
+}
+
+TEST(InmutableString_transforms, collapseWhitespace)
+{
+    InmutableString str("  Hello \t\n World  !");
+    EXPECT_EQ(str.collapseWhitespace(), " Hello World !");
+    EXPECT_EQ(str.collapseWhitespace().trim(), "Hello World !");
+}
+
+TEST(InmutableString_transforms, replaceChar)
+{
+    InmutableString str("a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q");
+    EXPECT_EQ(str.replace('.', '/'), "a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/q");
+    EXPECT_EQ(str.replace('x', '/'), str);
+}
+
+TEST(InmutableString_transforms, replaceAll)
+{
+    InmutableString str("one fish two fish red fish");
+    InmutableString fish("fish");
+    InmutableString cat("cat");
+    InmutableString whale("whale");
+    InmutableString empty;
+
+    EXPECT_EQ(str.replaceAll(fish.view(), cat.view()), "one cat two cat red cat");
+    EXPECT_EQ(str.replaceAll(fish.view(), whale.view()), "one whale two whale red whale");
+    EXPECT_EQ(str.replaceAll(fish.view(), empty.view()), "one  two  red ");
+    EXPECT_EQ(str.replaceAll(empty.view(), cat.view()), str);
+    EXPECT_EQ(str.replaceAll(whale.view(), cat.view()), str);
+}
+
+TEST(InmutableString_transforms, replaceAllNonOverlapping)
+{
+    InmutableString str("aaaaa");
+    InmutableString aa("aa");
+    InmutableString b("b");
+    EXPECT_EQ(str.replaceAll(aa.view(), b.view()), "bba");
+}
@@ -0,0 +1,227 @@
+#include <siminusminus/containers/numericconversions.hpp>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+
+//////////////////////
+// Numeric parsing
+//////////////////////
+
+namespace {
+
+template <typename T>
+ParseResult<T> parseInt(const char* text)
+{
+    InmutableString str(text);
+    return parseInteger<T>(str.view());
+}
+
+template <typename T>
+ParseResult<T> parseFloat(const char* text)
+{
+    InmutableString str(text);
+    return parseFloatingPoint<T>(str.view());
+}
+
+} // namespace
+
+TEST(NumericConversions_parseInteger, validNumbers)
+{
+    EXPECT_EQ(parseInt<int>("0").value, 0);
+    EXPECT_EQ(parseInt<int>("42").value, 42);
+    EXPECT_EQ(parseInt<int>("-42").value, -42);
+    EXPECT_EQ(parseInt<long long>("1234567890123456789").value, 1234567890123456789ll);
+    EXPECT_EQ(parseInt<long long>("-9223372036854775808").value, std::numeric_limits<long long>::min());
+    EXPECT_EQ(parseInt<unsigned long long>("18446744073709551615").value, std::numeric_limits<unsigned long long>::max());
+    EXPECT_EQ(parseInt<unsigned>("0000000000000000000000123").value, 123u);
+}
+
+TEST(NumericConversions_parseInteger, consumesTheLongestPrefix)
+{
+    auto result = parseInt<int>("12345678901,next");
+    EXPECT_EQ(result.error, ParseError::OutOfRange);
+    EXPECT_EQ(result.consumed, 11u);
+
+    result = parseInt<int>("123456789,next");
+    EXPECT_EQ(result.error, ParseError::None);
+    EXPECT_EQ(result.value, 123456789);
+    EXPECT_EQ(result.consumed, 9u);
+}
+
+TEST(NumericConversions_parseInteger, errors)
+{
+    EXPECT_EQ(parseInt<int>("").error, ParseError::InvalidInput);
+    EXPECT_EQ(parseInt<int>("-").error, ParseError::InvalidInput);
+    EXPECT_EQ(parseInt<int>("+1").error, ParseError::InvalidInput);
+    EXPECT_EQ(parseInt<int>(" 1").error, ParseError::InvalidInput);
+    EXPECT_EQ(parseInt<unsigned>("-1").error, ParseError::InvalidInput);
+    EXPECT_EQ(parseInt<int>("abc").consumed, 0u);
+    EXPECT_EQ(parseInt<signed char>("128").error, ParseError::OutOfRange);
+    EXPECT_EQ(parseInt<signed char>("-128").value, -128);
+    EXPECT_EQ(parseInt<long long>("9223372036854775808").error, ParseError::OutOfRange);
+    EXPECT_EQ(parseInt<unsigned long long>("18446744073709551616").error, ParseError::OutOfRange);
+    EXPECT_EQ(parseInt<unsigned long long>("99999999999999999999999").error, ParseError::OutOfRange);
+}
+
+TEST(NumericConversions_parseFloatingPoint, validNumbers)
+{
+    EXPECT_EQ(parseFloat<double>("0").value, 0.0);
+    EXPECT_EQ(parseFloat<double>("1.5").value, 1.5);
+    EXPECT_EQ(parseFloat<double>("-0.125").value, -0.125);
+    EXPECT_EQ(parseFloat<double>("1e10").value, 1e10);
+    EXPECT_EQ(parseFloat<double>("2.5E-3").value, 2.5e-3);
+    EXPECT_EQ(parseFloat<double>(".5").value, 0.5);
+    EXPECT_EQ(parseFloat<double>("5.").value, 5.0);
+    EXPECT_EQ(parseFloat<float>("3.14159").value, 3.14159f);
+    EXPECT_TRUE(std::signbit(parseFloat<double>("-0.0").value));
+}
+
+TEST(NumericConversions_parseFloatingPoint, matchesStrtod)
+{
+    const char* numbers[] = {
+        "0.1", "0.3", "123456789012345678901234567890", "1.7976931348623157e308",
+        "2.2250738585072014e-308", "4.9e-324", "0.000000000000000000000000000001234",
+        "9007199254740993", "1e23", "8.589973e9", "3.0000000000000004"
+    };
+
+    for (const char* number : numbers)
+    {
+        EXPECT_EQ(parseFloat<double>(number).value, std::strtod(number, nullptr)) << number;
+        EXPECT_EQ(parseFloat<float>(number).value, std::strtof(number, nullptr)) << number;
+    }
+}
+
+TEST(NumericConversions_parseFloatingPoint, specialValuesAndErrors)
+{
+    EXPECT_TRUE(std::isinf(parseFloat<double>("inf").value));
+    EXPECT_EQ(parseFloat<double>("-Infinity").consumed, 9u);
+    EXPECT_TRUE(std::isnan(parseFloat<double>("NaN").value));
+    EXPECT_EQ(parseFloat<double>("1e").consumed, 1u);
+    EXPECT_EQ(parseFloat<double>("1e+").consumed, 1u);
+    EXPECT_EQ(parseFloat<double>("1.5e3x").consumed, 5u);
+    EXPECT_EQ(parseFloat<double>("").error, ParseError::InvalidInput);
+    EXPECT_EQ(parseFloat<double>(".").error, ParseError::InvalidInput);
+    EXPECT_EQ(parseFloat<double>("-e5").error, ParseError::InvalidInput);
+    EXPECT_EQ(parseFloat<double>("1e999").error, ParseError::OutOfRange);
+    EXPECT_EQ(parseFloat<double>("1e-999").error, ParseError::OutOfRange);
+    EXPECT_EQ(parseFloat<float>("1e39").error, ParseError::OutOfRange);
+}
+
+//////////////////////
+// Numeric formatting
+//////////////////////
+
+TEST(NumericConversions_formatInteger, values)
+{
+    EXPECT_EQ(formatInteger(0), "0");
+    EXPECT_EQ(formatInteger(7), "7");
+    EXPECT_EQ(formatInteger(-42), "-42");
+    EXPECT_EQ(formatInteger(1234567890u), "1234567890");
+    EXPECT_EQ(formatInteger(std::numeric_limits<long long>::min()), "-9223372036854775808");
+    EXPECT_EQ(formatInteger(std::numeric_limits<unsigned long long>::max()), "18446744073709551615");
+
+    for (long long value = -100000; value <= 100000; value += 37)
+        EXPECT_EQ(formatInteger(value).toString(), std::to_string(value));
+}
+
+TEST(NumericConversions_formatFloatingPoint, shortestRoundTrip)
+{
+    EXPECT_EQ(formatFloatingPoint(0.1), "0.1");
+    EXPECT_EQ(formatFloatingPoint(1.5), "1.5");
+    EXPECT_EQ(formatFloatingPoint(-2.0), "-2");
+    EXPECT_EQ(formatFloatingPoint(0.1 + 0.2), "0.30000000000000004");
+    EXPECT_EQ(formatFloatingPoint(1e100), "1e+100");
+    EXPECT_EQ(formatFloatingPoint(0.1f), "0.1");
+    EXPECT_EQ(formatFloatingPoint(std::numeric_limits<double>::infinity()), "inf");
+    EXPECT_EQ(formatFloatingPoint(-std::numeric_limits<double>::infinity()), "-inf");
+    EXPECT_EQ(formatFloatingPoint(std::nan("")), "nan");
+
+    const double values[] = {
+        3.141592653589793, 2.2250738585072014e-308, 4.9e-324, -1.7976931348623157e308, 123456.789
+    };
+
+    for (double value : values)
+    {
+        InmutableString text = formatFloatingPoint(value);
+        EXPECT_EQ(parseFloatingPoint<double>(text.view()).value, value) << text;
+        EXPECT_LE(text.length(), NumericBufferSize::FloatingPoint);
+    }
+}
+
+TEST(NumericConversions_formatFloatingPoint, randomValuesUseTheFewestDigits)
+{
+    std::uint64_t state = 12345;
+
+    for (std::size_t i = 0; i < 20000; ++i)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double value;
+        std::memcpy(&value, &state, sizeof(value));
+
+        if (!std::isfinite(value))
+            continue;
+
+        char buffer[NumericBufferSize::FloatingPoint + 1];
+        *writeFloatingPoint(buffer, value) = '\0';
+        EXPECT_EQ(std::strtod(buffer, nullptr), value) << buffer;
+
+        // Significant digits of the shortest "%.*e" output that round trips
+        int fewest = 1;
+        char reference[32];
+
+        for (; fewest < 17; ++fewest)
+        {
+            std::snprintf(reference, sizeof(reference), "%.*e", fewest - 1, value);
+
+            if (std::strtod(reference, nullptr) == value)
+                break;
+        }
+
+        const std::string text(buffer, std::strcspn(buffer, "e"));
+        const std::size_t first = text.find_first_not_of("-0.");
+        const std::size_t last = text.find_last_not_of("0.");
+        const std::size_t digits = last + 1 - first - std::count(text.begin() + first, text.begin() + last, '.');
+
+        EXPECT_EQ(digits, static_cast<std::size_t>(fewest)) << buffer;
+    }
+}
+
+TEST(NumericConversions_locale, independentOfTheGlobalLocale)
+{
+    // Nothing to check if no locale with a ',' decimal separator is installed
+    const char* const locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "es_ES.UTF-8", "ru_RU.UTF-8"};
+    const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    bool switched = false;
+
+    for (const char* locale : locales)
+        if (!switched && std::setlocale(LC_NUMERIC, locale) != nullptr)
+            switched = *std::localeconv()->decimal_point == ',';
+
+    if (!switched)
+    {
+        std::setlocale(LC_NUMERIC, previous.c_str());
+        return;
+    }
+
+    InmutableString exact("1.5");
+    InmutableString slow("3.14159265358979323846264338327950288");
+
+    EXPECT_EQ(parseFloatingPoint<double>(exact.view()).value, 1.5);
+    EXPECT_EQ(parseFloatingPoint<double>(slow.view()).value, 3.141592653589793);
+    EXPECT_EQ(parseFloatingPoint<double>(slow.view()).consumed, slow.length());
+    EXPECT_EQ(parseFloatingPoint<float>(slow.view()).value, 3.1415927f);
+    EXPECT_EQ(formatFloatingPoint(1.5), "1.5");
+    EXPECT_EQ(formatFloatingPoint(0.1 + 0.2), "0.30000000000000004");
+    EXPECT_EQ(formatFloatingPoint(0.1f), "0.1");
+
+    std::setlocale(LC_NUMERIC, previous.c_str());
+}
@@ -0,0 +1,151 @@
+#include <siminusminus/containers/parallelscanner.hpp>
+#include <siminusminus/containers/inmutablestring.hpp>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+using namespace ::cmm::utils;
+
+///////////////////
+// ParallelScanner
+///////////////////
+
+namespace {
+
+/**
+ * Pseudo random text over a small alphabet, long enough to span many chunks.
+ */
+std::string randomText(std::size_t length)
+{
+    std::string text(length, ' ');
+    unsigned int seed = 12345;
+
+    for (char& c : text)
+    {
+        seed = seed * 1103515245u + 12345u;
+        c = static_cast<char>('a' + (seed >> 16) % 4);
+    }
+
+    return text;
+}
+
+} // namespace
+
+TEST(ParallelScanner_chunks, alignedAndCovering)
+{
+    ThreadPool pool(2);
+    ParallelScanner scanner(pool, 100);
+    InmutableString text(randomText(1000).c_str());
+
+    EXPECT_EQ(scanner.chunkSize(), 128u);
+
+    auto parts = scanner.chunks(text.view());
+    const char* expected = text.view().data();
+
+    for (std::size_t i = 0; i < parts.size(); ++i)
+    {
+        EXPECT_EQ(parts[i].data(), expected);
+        EXPECT_FALSE(parts[i].empty());
+
+        if (i + 1 != parts.size())
+        {
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(parts[i].data() + parts[i].size()) % 64, 0u);
+        }
+
+        expected += parts[i].size();
+    }
+
+    EXPECT_EQ(expected, text.view().data() + text.length());
+}
+
+TEST(ParallelScanner_count, matchesSequentialCount)
+{
+    ThreadPool pool(3);
+    ParallelScanner scanner(pool, 64);
+    const std::string text = randomText(10007);
+    InmutableString itext(text.c_str());
+
+    EXPECT_EQ(scanner.count(itext.view(), 'a'), static_cast<std::size_t>(std::count(text.begin(), text.end(), 'a')));
+    EXPECT_EQ(scanner.count(itext.view(), 'z'), 0u);
+}
+
+TEST(ParallelScanner_findFirst, firstOccurrenceAcrossChunks)
+{
+    ThreadPool pool(4);
+    ParallelScanner scanner(pool, 64);
+    std::string text(5000, '.');
+    const ConstContiguousView<char> view(text.data(), text.data() + text.size());
+
+    // The boundaries depend on the alignment of the text, so the needle is placed
+    // across the end of the first chunk, wherever it falls
+    const auto parts = scanner.chunks(view);
+    ASSERT_GE(parts.size(), 2u);
+    ASSERT_GE(parts[0].size(), 3u);
+    const std::size_t crossing = parts[0].size() - 3;
+
+    text.replace(4000, 6, "needle");
+    text.replace(crossing, 6, "needle");
+    text[3000] = '#';
+
+    InmutableString needle("needle");
+    InmutableString missing("needles");
+
+    EXPECT_EQ(scanner.findFirst(view, needle.view()), crossing);
+    EXPECT_EQ(scanner.findFirst(view, missing.view()), ParallelScanner::NotFound);
+    EXPECT_EQ(scanner.findFirst(view, '#'), 3000u);
+    EXPECT_EQ(scanner.findFirst(view, '@'), ParallelScanner::NotFound);
+}
+
+TEST(ParallelScanner_findAll, matchesSequentialSearch)
+{
+    ThreadPool pool(4);
+    ParallelScanner scanner(pool, 64);
+    const std::string text = randomText(20000);
+    InmutableString itext(text.c_str());
+    InmutableString needle("abca");
+
+    std::vector<std::size_t> expected;
+
+    for (std::size_t pos = text.find("abca"); pos != std::string::npos; pos = text.find("abca", pos + 1))
+        expected.push_back(pos);
+
+    EXPECT_EQ(scanner.findAll(itext.view(), needle.view()), expected);
+}
+
+TEST(ParallelScanner_histogram, matchesSequentialHistogram)
+{
+    ThreadPool pool(2);
+    ParallelScanner scanner(pool, 256);
+    const std::string text = randomText(9999);
+    InmutableString itext(text.c_str());
+
+    auto histogram = scanner.histogram(itext.view());
+
+    EXPECT_EQ(histogram['a'] + histogram['b'] + histogram['c'] + histogram['d'], text.size());
+    EXPECT_EQ(histogram['c'], static_cast<std::size_t>(std::count(text.begin(), text.end(), 'c')));
+    EXPECT_EQ(histogram['e'], 0u);
+}
+
+TEST(ParallelScanner_reduce, keepsChunkOrder)
+{
+    ThreadPool pool(4);
+    ParallelScanner scanner(pool, 64);
+    const std::string text = randomText(3000);
+    InmutableString itext(text.c_str());
+
+    // Concatenation is associative but not commutative
+    std::string copy = scanner.reduce(itext.view(), std::string(),
+        [](const ConstContiguousView<char>& chunk)
+        {
+            return std::string(chunk.data(), chunk.size());
+        },
+        [](const std::string& lhs, const std::string& rhs)
+        {
+            return lhs + rhs;
+        });
+
+    EXPECT_EQ(copy, text);
+}
@@ -0,0 +1,245 @@
+#include <siminusminus/containers/sketches.hpp>
+#include <gmock/gmock.h>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+
+/////////////
+// Sketches
+/////////////
+
+namespace {
+
+std::string key(std::size_t i)
+{
+    return "key-" + std::to_string(i);
+}
+
+ConstContiguousView<char> viewOf(const std::string& str)
+{
+    return ConstContiguousView<char>(str.data(), str.data() + str.size());
+}
+
+ConstContiguousView<char> viewOf(const std::vector<char>& bytes)
+{
+    return ConstContiguousView<char>(bytes.data(), bytes.data() + bytes.size());
+}
+
+} // namespace
+
+TEST(Sketches_hashKey, dependsOnEveryByte)
+{
+    const std::string base("a key long enough to span several words");
+    const std::uint64_t hash = hashKey(viewOf(base));
+
+    EXPECT_EQ(hashKey(viewOf(base)), hash);
+
+    for (std::size_t i = 0; i < base.size(); ++i)
+    {
+        std::string changed = base;
+        changed[i] ^= 1;
+
+        EXPECT_NE(hashKey(viewOf(changed)), hash) << i;
+    }
+
+    EXPECT_NE(hashKey(viewOf(base.substr(0, 9))), hashKey(viewOf(base.substr(0, 10))));
+}
+
+TEST(Sketches_bloomFilter, noFalseNegativesAndFewFalsePositives)
+{
+    BloomFilter filter(64 * 1024);
+    std::size_t falsePositives = 0;
+
+    for (std::size_t i = 0; i < 50000; ++i)
+        filter.insert(viewOf(key(i)));
+
+    for (std::size_t i = 0; i < 50000; ++i)
+        ASSERT_TRUE(filter.mayContain(viewOf(key(i))));
+
+    for (std::size_t i = 50000; i < 100000; ++i)
+        falsePositives += filter.mayContain(viewOf(key(i)));
+
+    // About 10 bits per key, 8 hashes: below 2% for a blocked filter
+    EXPECT_LT(falsePositives, 1000u);
+    EXPECT_EQ(filter.sizeInBytes(), 64u * 1024);
+}
+
+TEST(Sketches_bloomFilter, probesAreIndependent)
+{
+    // Keys of a one block filter set its 512 bits like independent uniform probes
+    for (std::size_t hashes : {8u, 15u})
+    {
+        const std::size_t keys = 30;
+        const std::size_t filters = 200;
+        const double expected = 512 * (1 - std::pow(511.0 / 512, static_cast<double>(hashes * keys)));
+        std::size_t setBits = 0;
+
+        for (std::size_t i = 0; i < filters; ++i)
+        {
+            BloomFilter filter(64, hashes);
+            std::vector<char> bytes;
+
+            for (std::size_t j = 0; j < keys; ++j)
+                filter.insert(viewOf(key(i * keys + j)));
+
+            filter.serialize(bytes);
+
+            for (std::size_t j = 16; j < bytes.size(); ++j)
+                setBits += std::bitset<8>(static_cast<unsigned char>(bytes[j])).count();
+        }
+
+        EXPECT_NEAR(static_cast<double>(setBits) / filters, expected, 0.01 * expected) << hashes;
+    }
+}
+
+TEST(Sketches_bloomFilter, mergeAndSerialize)
+{
+    BloomFilter first(4096);
+    BloomFilter second(4096);
+    BloomFilter restored(64);
+    std::vector<char> bytes;
+
+    for (std::size_t i = 0; i < 100; ++i)
+        (i % 2 ? first : second).insert(viewOf(key(i)));
+
+    EXPECT_FALSE(first.merge(BloomFilter(8192)));
+    EXPECT_TRUE(first.merge(second));
+
+    const std::size_t written = first.serialize(bytes);
+    EXPECT_EQ(written, bytes.size());
+    EXPECT_EQ(written, 16u + 4096u);
+    EXPECT_TRUE(restored.deserialize(viewOf(bytes)));
+    EXPECT_EQ(restored.sizeInBytes(), 4096u);
+
+    for (std::size_t i = 0; i < 100; ++i)
+        EXPECT_TRUE(restored.mayContain(viewOf(key(i))));
+
+    bytes.pop_back();
+    EXPECT_FALSE(restored.deserialize(viewOf(bytes)));
+    EXPECT_EQ(restored.sizeInBytes(), 4096u);
+}
+
+TEST(Sketches_hyperLogLog, estimatesDistinctKeys)
+{
+    for (std::size_t distinct : {0u, 10u, 1000u, 200000u})
+    {
+        HyperLogLog sketch;
+
+        for (std::size_t repeat = 0; repeat < 3; ++repeat)
+            for (std::size_t i = 0; i < distinct; ++i)
+                sketch.insert(viewOf(key(i)));
+
+        // Well within 4 standard errors (0.8% each)
+        EXPECT_NEAR(sketch.estimate(), static_cast<double>(distinct), 0.04 * distinct + 1) << distinct;
+    }
+}
+
+TEST(Sketches_hyperLogLog, mergeAndSerialize)
+{
+    HyperLogLog first(12);
+    HyperLogLog second(12);
+    HyperLogLog all(12);
+    HyperLogLog restored;
+    std::vector<char> bytes;
+
+    for (std::size_t i = 0; i < 20000; ++i)
+    {
+        (i % 3 ? first : second).insert(viewOf(key(i)));
+        all.insert(viewOf(key(i)));
+    }
+
+    EXPECT_FALSE(first.merge(HyperLogLog(10)));
+    EXPECT_TRUE(first.merge(second));
+    EXPECT_EQ(first.estimate(), all.estimate());
+
+    first.serialize(bytes);
+    EXPECT_EQ(bytes.size(), 8u + 4096u);
+    EXPECT_TRUE(restored.deserialize(viewOf(bytes)));
+    EXPECT_EQ(restored.precision(), 12u);
+    EXPECT_EQ(restored.estimate(), all.estimate());
+
+    bytes[0] = 'X';
+    EXPECT_FALSE(restored.deserialize(viewOf(bytes)));
+}
+
+TEST(Sketches_countMinSketch, neverUnderestimates)
+{
+    CountMinSketch sketch(1000, 4);
+    std::uint64_t overestimation = 0;
+
+    EXPECT_EQ(sketch.width(), 1024u);
+    EXPECT_EQ(sketch.depth(), 4u);
+
+    for (std::size_t i = 0; i < 5000; ++i)
+        sketch.insert(viewOf(key(i)), i % 10 + 1);
+
+    for (std::size_t i = 0; i < 5000; ++i)
+    {
+        const std::uint64_t estimate = sketch.estimate(viewOf(key(i)));
+
+        ASSERT_GE(estimate, i % 10 + 1);
+        overestimation += estimate - (i % 10 + 1);
+    }
+
+    EXPECT_EQ(sketch.total(), 27500u);
+    EXPECT_LT(overestimation / 5000, sketch.total() * 3 / sketch.width());
+}
+
+TEST(Sketches_countMinSketch, mergeAndSerialize)
+{
+    CountMinSketch first(256, 3);
+    CountMinSketch second(256, 3);
+    CountMinSketch restored(1, 1);
+    std::vector<char> bytes;
+    const std::string hot("hot key");
+    const std::uint64_t hash = hashKey(viewOf(hot));
+
+    first.insertHash(hash, 5);
+    second.insert(viewOf(hot), 7);
+
+    EXPECT_FALSE(first.merge(CountMinSketch(256, 2)));
+    EXPECT_TRUE(first.merge(second));
+    EXPECT_EQ(first.estimateHash(hash), 12u);
+
+    first.serialize(bytes);
+    EXPECT_TRUE(restored.deserialize(viewOf(bytes)));
+    EXPECT_EQ(restored.width(), 256u);
+    EXPECT_EQ(restored.depth(), 3u);
+    EXPECT_EQ(restored.total(), 12u);
+    EXPECT_EQ(restored.estimate(viewOf(hot)), 12u);
+}
+
+TEST(Sketches_countMinSketch, rejectsImpossibleSizes)
+{
+    const std::size_t largest = std::numeric_limits<std::size_t>::max();
+
+    EXPECT_THROW(CountMinSketch(largest, 1), std::length_error);
+    EXPECT_THROW(CountMinSketch(largest / 2 + 2, 1), std::length_error);
+    EXPECT_THROW(CountMinSketch(1024, largest / 512), std::length_error);
+}
+
+TEST(Sketches_keys, inmutableStringKeys)
+{
+    const InmutableString hot("hot key");
+    const InmutableString cold("cold key");
+    BloomFilter filter(1024);
+    HyperLogLog distinct;
+    CountMinSketch hits(256, 3);
+
+    filter.insert(hot);
+    distinct.insert(hot);
+    distinct.insert(InmutableString("hot key"));
+    hits.insert(hot, 3);
+
+    EXPECT_TRUE(filter.mayContain(hot));
+    EXPECT_EQ(filter.mayContain(cold), filter.mayContain(cold.view()));
+    EXPECT_NEAR(distinct.estimate(), 1.0, 0.1);
+    EXPECT_EQ(hits.estimate(hot), 3u);
+    EXPECT_EQ(hits.estimate(hot), hits.estimateHash(hashKey(hot.view())));
+}
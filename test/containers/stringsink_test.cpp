@@ -0,0 +1,164 @@
+#include <siminusminus/containers/stringsink.hpp>
+#include <gmock/gmock.h>
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+
+///////////////
+// StringSink
+///////////////
+
+namespace {
+
+/**
+ * Temporary file, read back after the sink is done with it.
+ */
+class TemporaryFile
+{
+public:
+
+    TemporaryFile(): _file(std::tmpfile()) {}
+    ~TemporaryFile() { std::fclose(_file); }
+
+    int fd() const
+    {
+        return fileno(_file);
+    }
+
+    std::string contents() const
+    {
+        std::string result;
+        char buffer[4096];
+        ssize_t read;
+
+        ::lseek(fd(), 0, SEEK_SET);
+
+        while ((read = ::read(fd(), buffer, sizeof(buffer))) > 0)
+            result.append(buffer, static_cast<std::size_t>(read));
+
+        return result;
+    }
+
+private:
+
+    std::FILE* _file;
+};
+
+/**
+ * Strings of many lengths, so some are staged and some are written in place.
+ */
+std::vector<InmutableString> lines(std::size_t count)
+{
+    std::vector<InmutableString> result;
+
+    for (std::size_t i = 0; i < count; ++i)
+        result.emplace_back((std::to_string(i) + std::string(i % 1500, 'x') + "\n").c_str());
+
+    return result;
+}
+
+} // namespace
+
+TEST(StringSink_write, writesEverythingInOrder)
+{
+    for (StringSink::Mode mode : {StringSink::Mode::Synchronous, StringSink::Mode::Background})
+    {
+        TemporaryFile file;
+        const std::vector<InmutableString> strings = lines(3000);
+        std::string expected;
+
+        {
+            StringSink sink(file.fd(), mode, 4096, 256);
+
+            for (const InmutableString& str : strings)
+            {
+                sink.write(str);
+                expected += str.toString();
+            }
+
+            EXPECT_TRUE(sink.flush());
+            EXPECT_EQ(sink.bytesWritten(), expected.size());
+            EXPECT_EQ(sink.error(), 0);
+        }
+
+        EXPECT_EQ(file.contents(), expected);
+    }
+}
+
+TEST(StringSink_write, keepsMovedStrings)
+{
+    TemporaryFile file;
+    std::string expected;
+
+    {
+        StringSink sink(file.fd(), StringSink::Mode::Background, 1024, 16);
+
+        for (InmutableString& str : lines(500))
+        {
+            expected += str.toString();
+            sink.write(std::move(str));
+        }
+    }
+
+    EXPECT_EQ(file.contents(), expected);
+}
+
+TEST(StringSink_write, keepsTemporariesOfOtherStorages)
+{
+    typedef BasicInmutableString<SharedStorage, NoLogging, char> SharedString;
+
+    TemporaryFile file;
+    const std::string longLine = std::string(100, 'y') + "\n";
+
+    {
+        // The long strings are held back until the flush, after the temporaries are gone
+        StringSink sink(file.fd(), StringSink::Mode::Synchronous, 1024, 16);
+
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            sink.write(SharedString(longLine.c_str()));
+            sink.write(SharedString("short\n"));
+        }
+
+        EXPECT_EQ(sink.bytesWritten(), 0u);
+        EXPECT_TRUE(sink.flush());
+    }
+
+    std::string expected;
+
+    for (std::size_t i = 0; i < 10; ++i)
+        expected += longLine + "short\n";
+
+    EXPECT_EQ(file.contents(), expected);
+}
+
+TEST(StringSink_write, viewsNeedNotBeTerminated)
+{
+    TemporaryFile file;
+    const char text[] = {'a', 'b', 'c', 'd'};
+
+    {
+        StringSink sink(file.fd());
+        sink.write(ConstContiguousView<char>(text, text + 2));
+        sink.write(ConstContiguousView<char>(text + 3, text + 4));
+        sink.write(ConstContiguousView<char>(text, text));
+    }
+
+    EXPECT_EQ(file.contents(), "abd");
+}
+
+TEST(StringSink_error, reportsTheFirstFailedWrite)
+{
+    StringSink sink(-1);
+    InmutableString str("lost");
+
+    sink.write(str);
+
+    EXPECT_FALSE(sink.flush());
+    EXPECT_EQ(sink.error(), EBADF);
+    EXPECT_EQ(sink.bytesWritten(), 0u);
+}
@@ -0,0 +1,238 @@
+#include <siminusminus/containers/suffixindex.hpp>
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+using namespace ::testing;
+using namespace ::cmm::containers;
+
+////////////////
+// SuffixIndex
+////////////////
+
+namespace {
+
+/**
+ * Pseudo random string over a small alphabet, so there are long repeats.
+ */
+std::string randomString(unsigned int& seed, std::size_t length, std::size_t alphabet)
+{
+    std::string result(length, ' ');
+
+    for (char& c : result)
+    {
+        seed = seed * 1103515245u + 12345u;
+        c = static_cast<char>('a' + (seed >> 16) % alphabet);
+    }
+
+    return result;
+}
+
+ConstContiguousView<char> viewOf(const std::string& str)
+{
+    return ConstContiguousView<char>(str.data(), str.data() + str.size());
+}
+
+std::vector<std::size_t> naiveFindAll(const std::string& text, const std::string& pattern)
+{
+    std::vector<std::size_t> offsets;
+
+    for (std::size_t i = text.find(pattern); i != std::string::npos; i = text.find(pattern, i + 1))
+        offsets.push_back(i);
+
+    return offsets;
+}
+
+/**
+ * Checks the suffix and LCP arrays against the sorted suffixes.
+ */
+void expectSortedSuffixes(const SuffixIndex& index, const std::string& text)
+{
+    ASSERT_EQ(index.length(), text.size());
+
+    for (std::size_t i = 1; i < text.size(); ++i)
+    {
+        const std::string previous = text.substr(index.suffix(i - 1));
+        const std::string current = text.substr(index.suffix(i));
+        const std::size_t common = std::mismatch(previous.begin(), previous.begin() + std::min(previous.size(), current.size()),
+                                                 current.begin()).first - previous.begin();
+
+        EXPECT_LT(previous, current);
+        EXPECT_EQ(index.lcp(i), common) << "suffix " << i;
+    }
+}
+
+/**
+ * Path of a new temporary file, removed on destruction.
+ */
+class TemporaryPath
+{
+public:
+
+    TemporaryPath()
+    {
+        std::strcpy(_path, "/tmp/suffixindexXXXXXX");
+        ::close(::mkstemp(_path));
+    }
+
+    ~TemporaryPath() { std::remove(_path); }
+
+    const char* path() const
+    {
+        return _path;
+    }
+
+private:
+
+    char _path[32];
+};
+
+} // namespace
+
+TEST(SuffixIndex_construction, sortsAllTheSuffixes)
+{
+    unsigned int seed = 5;
+
+    for (std::size_t length : {0u, 1u, 2u, 3u, 17u, 1000u})
+    {
+        for (std::size_t alphabet : {1u, 2u, 4u, 26u})
+        {
+            const std::string text = randomString(seed, length, alphabet);
+            SuffixIndex index(viewOf(text));
+
+            expectSortedSuffixes(index, text);
+        }
+    }
+
+    const std::string banana("banana");
+    SuffixIndex index(viewOf(banana));
+    std::vector<std::size_t> suffixes;
+
+    for (std::size_t i = 0; i < banana.size(); ++i)
+        suffixes.push_back(index.suffix(i));
+
+    EXPECT_THAT(suffixes, ElementsAre(5, 3, 1, 0, 4, 2));
+}
+
+TEST(SuffixIndex_construction, parallelLcpMatchesSequential)
+{
+    unsigned int seed = 11;
+    const std::string text = randomString(seed, 300000, 2) + randomString(seed, 100000, 1);
+    ::cmm::utils::ThreadPool pool(4);
+    SuffixIndex sequential(viewOf(text));
+    SuffixIndex parallel(viewOf(text), pool);
+
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        ASSERT_EQ(parallel.suffix(i), sequential.suffix(i));
+        ASSERT_EQ(parallel.lcp(i), sequential.lcp(i)) << "suffix " << i;
+    }
+}
+
+TEST(SuffixIndex_queries, matchNaiveSearch)
+{
+    unsigned int seed = 21;
+    const std::string text = randomString(seed, 5000, 3);
+    SuffixIndex index(viewOf(text));
+
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        const std::string pattern = randomString(seed, 1 + i % 9, 4);
+        const std::vector<std::size_t> expected = naiveFindAll(text, pattern);
+        std::vector<std::size_t> offsets;
+
+        EXPECT_EQ(index.count(viewOf(pattern)), expected.size()) << pattern;
+        EXPECT_EQ(index.findAll(viewOf(pattern), offsets), expected.size());
+        EXPECT_EQ(offsets, expected);
+
+        const std::size_t located = index.locate(viewOf(pattern));
+
+        if (expected.empty())
+            EXPECT_EQ(located, SuffixIndex::NotFound);
+        else
+            EXPECT_EQ(text.compare(located, pattern.size(), pattern), 0);
+    }
+}
+
+TEST(SuffixIndex_files, saveAndMap)
+{
+    const std::string text("to be or not to be, that is the question");
+    const std::string pattern("be");
+    TemporaryPath file;
+    SuffixIndex mapped;
+
+    {
+        SuffixIndex built(viewOf(text));
+        ASSERT_TRUE(built.save(file.path()));
+    }
+
+    ASSERT_TRUE(mapped.open(file.path()));
+    EXPECT_EQ(std::string(mapped.text().data(), mapped.text().size()), text);
+    expectSortedSuffixes(mapped, text);
+
+    std::vector<std::size_t> offsets;
+    mapped.findAll(viewOf(pattern), offsets);
+    EXPECT_THAT(offsets, ElementsAre(3, 16));
+}
+
+TEST(SuffixIndex_files, rejectsOtherFiles)
+{
+    TemporaryPath file;
+    SuffixIndex index;
+
+    EXPECT_FALSE(index.open("/this/path/does/not/exist"));
+
+    std::FILE* other = std::fopen(file.path(), "w");
+    std::fputs("definitely not an index file", other);
+    std::fclose(other);
+
+    EXPECT_FALSE(index.open(file.path()));
+    EXPECT_EQ(index.length(), 0u);
+    EXPECT_EQ(index.count(viewOf("x")), 0u);
+}
+
+TEST(SuffixIndex_files, rejectsCorruptedEntries)
+{
+    const std::string text("abracadabra");
+    TemporaryPath file;
+    SuffixIndex index;
+
+    {
+        SuffixIndex built(viewOf(text));
+        ASSERT_TRUE(built.save(file.path()));
+    }
+
+    // Header of 16 bytes, then the text padded to 16 bytes, the suffix array and the LCP array
+    const long suffixes = 16 + 16;
+    const long lcp = suffixes + 8 * static_cast<long>(text.size());
+    const std::uint64_t pastTheEnd = text.size();
+    const std::uint64_t tooLong = text.size() + 1;
+    std::uint64_t original;
+
+    std::FILE* stream = std::fopen(file.path(), "r+b");
+    ASSERT_NE(stream, nullptr);
+    std::fseek(stream, suffixes + 8 * 3, SEEK_SET);
+    ASSERT_EQ(std::fread(&original, sizeof(original), 1, stream), 1u);
+    std::fseek(stream, suffixes + 8 * 3, SEEK_SET);
+    std::fwrite(&pastTheEnd, sizeof(pastTheEnd), 1, stream);
+    std::fflush(stream);
+
+    EXPECT_FALSE(index.open(file.path()));
+    EXPECT_EQ(index.length(), 0u);
+
+    std::fseek(stream, suffixes + 8 * 3, SEEK_SET);
+    std::fwrite(&original, sizeof(original), 1, stream);
+    std::fflush(stream);
+    EXPECT_TRUE(index.open(file.path()));
+
+    std::fseek(stream, lcp + 8 * 5, SEEK_SET);
+    std::fwrite(&tooLong, sizeof(tooLong), 1, stream);
+    std::fclose(stream);
+
+    EXPECT_FALSE(index.open(file.path()));
+    EXPECT_EQ(index.count(viewOf("abra")), 0u);
+}
@@ -0,0 +1,67 @@
+#include <siminusminus/utils/threadpool.hpp>
+#include <gmock/gmock.h>
+
+using namespace ::testing;
+using namespace ::cmm::utils;
+
+//////////////
+// ThreadPool
+//////////////
+
+TEST(ThreadPool_submit, runsAllTasksBeforeDestruction)
+{
+    std::atomic<int> counter(0);
+
+    {
+        ThreadPool pool(4);
+
+        for (int i = 0; i < 1000; ++i)
+            pool.submit([&counter]() { ++counter; });
+    }
+
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPool_submit, withoutWorkers)
+{
+    ThreadPool pool(0);
+    int counter = 0;
+
+    pool.submit([&counter]() { ++counter; });
+
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(counter, 1);
+}
+
+TEST(ThreadPool_parallelFor, visitsEachIndexOnce)
+{
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> visits(10000);
+
+    for (std::atomic<int>& visit : visits)
+        visit = 0;
+
+    pool.parallelFor(visits.size(), [&visits](std::size_t i)
+    {
+        ++visits[i];
+    });
+
+    for (std::atomic<int>& visit : visits)
+        EXPECT_EQ(visit.load(), 1);
+}
+
+TEST(ThreadPool_parallelFor, nested)
+{
+    ThreadPool pool(2);
+    std::atomic<std::size_t> total(0);
+
+    pool.parallelFor(8, [&pool, &total](std::size_t)
+    {
+        pool.parallelFor(100, [&total](std::size_t i)
+        {
+            total += i;
+        });
+    });
+
+    EXPECT_EQ(total.load(), 8u * 4950u);
+}
@@ -0,0 +1,161 @@
+#ifndef SIMINUSMINUS_TRACING
+    #define SIMINUSMINUS_TRACING
+#endif
+
+#include <siminusminus/utils/tracing.hpp>
+#include <siminusminus/utils/threadpool.hpp>
+#include <gmock/gmock.h>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+using namespace ::testing;
+using namespace ::cmm::utils;
+
+//////////
+// Tracer
+//////////
+
+namespace {
+
+std::string exportTrace(std::size_t& events)
+{
+    std::ostringstream os;
+    events = Tracer::exportChromeTrace(os);
+    return os.str();
+}
+
+} // namespace
+
+TEST(Tracer_record, spansAndCounters)
+{
+    Tracer::start();
+    EXPECT_TRUE(Tracer::enabled());
+
+    {
+        SIMINUSMINUS_TRACE_SCOPE("outer");
+        SIMINUSMINUS_TRACE_COUNTER("items", 42);
+    }
+
+    Tracer::stop();
+
+    std::size_t events;
+    const std::string trace = exportTrace(events);
+
+    EXPECT_EQ(events, 2u);
+    EXPECT_THAT(trace, StartsWith("{\"traceEvents\":["));
+    EXPECT_THAT(trace, HasSubstr("{\"name\":\"outer\",\"ph\":\"X\",\"pid\":1,"));
+    EXPECT_THAT(trace, HasSubstr("\"dur\":"));
+    EXPECT_THAT(trace, HasSubstr("{\"name\":\"items\",\"ph\":\"C\","));
+    EXPECT_THAT(trace, HasSubstr("\"args\":{\"value\":42}}"));
+}
+
+TEST(Tracer_record, onlyWhileRecording)
+{
+    Tracer::start();
+    Tracer::stop();
+    EXPECT_FALSE(Tracer::enabled());
+
+    {
+        SIMINUSMINUS_TRACE_SCOPE("ignored");
+        SIMINUSMINUS_TRACE_COUNTER("ignored", 1);
+    }
+
+    std::size_t events;
+    const std::string trace = exportTrace(events);
+
+    EXPECT_EQ(events, 0u);
+    EXPECT_THAT(trace, Not(HasSubstr("ignored")));
+}
+
+TEST(Tracer_record, startDiscardsThePreviousTrace)
+{
+    Tracer::start();
+    SIMINUSMINUS_TRACE_COUNTER("first trace", 1);
+    Tracer::start();
+    SIMINUSMINUS_TRACE_COUNTER("second trace", 2);
+    Tracer::stop();
+
+    std::size_t events;
+    const std::string trace = exportTrace(events);
+
+    EXPECT_EQ(events, 1u);
+    EXPECT_THAT(trace, HasSubstr("second trace"));
+    EXPECT_THAT(trace, Not(HasSubstr("first trace")));
+}
+
+TEST(Tracer_record, everyThreadHasItsBuffer)
+{
+    ThreadPool pool(4);
+
+    Tracer::start();
+
+    pool.parallelFor(1000, [](std::size_t)
+    {
+        SIMINUSMINUS_TRACE_SCOPE("task");
+    });
+
+    Tracer::stop();
+
+    std::size_t events;
+    exportTrace(events);
+
+    EXPECT_EQ(events, 1000u);
+}
+
+TEST(Tracer_record, finishedThreadsGiveTheirBufferBack)
+{
+    Tracer::start();
+
+    for (std::size_t i = 0; i < 20; ++i)
+    {
+        std::thread thread([]()
+        {
+            SIMINUSMINUS_TRACE_COUNTER("thread", 1);
+        });
+
+        thread.join();
+    }
+
+    Tracer::stop();
+
+    std::size_t events;
+    const std::string trace = exportTrace(events);
+    const std::regex tid("\"tid\":([0-9]+)");
+    std::set<std::string> tids;
+
+    for (std::sregex_iterator it(trace.begin(), trace.end(), tid); it != std::sregex_iterator(); ++it)
+        tids.insert((*it)[1].str());
+
+    EXPECT_EQ(events, 20u);
+    EXPECT_EQ(tids.size(), 1u);
+}
+
+TEST(Tracer_record, dropsEventsOfFullBuffers)
+{
+    Tracer::start();
+
+    for (std::size_t i = 0; i < Tracer::EventsPerThread + 10; ++i)
+        Tracer::counter("counter", static_cast<std::int64_t>(i));
+
+    Tracer::stop();
+
+    std::size_t events;
+    exportTrace(events);
+
+    EXPECT_EQ(events, Tracer::EventsPerThread);
+    EXPECT_EQ(Tracer::droppedEvents(), 10u);
+}
+
+TEST(Tracer_export, escapesNames)
+{
+    Tracer::start();
+    Tracer::span("quoted \"name\"\\\n", Tracer::now(), Tracer::now());
+    Tracer::stop();
+
+    std::size_t events;
+    const std::string trace = exportTrace(events);
+
+    EXPECT_THAT(trace, HasSubstr("\"quoted \\\"name\\\"\\\\\\u000a\""));
+}